@@ -0,0 +1,457 @@
+/**
+  ******************************************************************************
+  * @file    Crc16.cpp
+  * @author  SerialPortYmodem contributors
+  * @version v1.0
+  * @date    16-October-2026
+  * @brief   CRC16-CCITT module source file.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>Copyright &copy; 2026 SerialPortYmodem contributors</center></h2>
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+/* Header includes -----------------------------------------------------------*/
+#include "Crc16.h"
+
+#ifdef CRC16_CLMUL
+#include <emmintrin.h>
+#include <tmmintrin.h>
+#include <wmmintrin.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+/* Macro definitions ---------------------------------------------------------*/
+#define CRC16_TABLE_4(k, n)    crc16Slice(k, (n) + 0),  crc16Slice(k, (n) + 1),   \
+                               crc16Slice(k, (n) + 2),  crc16Slice(k, (n) + 3)
+#define CRC16_TABLE_16(k, n)   CRC16_TABLE_4(k, (n) + 0),  CRC16_TABLE_4(k, (n) + 4),   \
+                               CRC16_TABLE_4(k, (n) + 8),  CRC16_TABLE_4(k, (n) + 12)
+#define CRC16_TABLE_64(k, n)   CRC16_TABLE_16(k, (n) + 0), CRC16_TABLE_16(k, (n) + 16), \
+                               CRC16_TABLE_16(k, (n) + 32), CRC16_TABLE_16(k, (n) + 48)
+#define CRC16_TABLE_256(k)     { CRC16_TABLE_64(k, 0),  CRC16_TABLE_64(k, 64),           \
+                                 CRC16_TABLE_64(k, 128), CRC16_TABLE_64(k, 192) }
+
+#ifdef CRC16_CLMUL
+#ifdef _MSC_VER
+#define CRC16_CLMUL_TARGET
+#else
+#define CRC16_CLMUL_TARGET     __attribute__((target("sse2,ssse3,pclmul")))
+#endif
+
+#define CRC16_CLMUL_BLOCK      (16)
+#define CRC16_CLMUL_MIN        (4 * CRC16_CLMUL_BLOCK)
+#endif
+
+/* Type definitions ----------------------------------------------------------*/
+/* Variable declarations -----------------------------------------------------*/
+
+/* Function declarations -----------------------------------------------------*/
+static constexpr uint16_t crc16Shift(uint16_t crc, uint32_t bits);
+static constexpr uint16_t crc16Entry(uint32_t n);
+static constexpr uint16_t crc16Slice(uint32_t k, uint32_t n);
+static constexpr uint16_t crc16Power(uint16_t crc, uint32_t bytes);
+
+#ifdef CRC16_CLMUL
+static bool crc16ClmulDetect();
+#endif
+
+/* Function definitions ------------------------------------------------------*/
+
+/**
+  * @brief  Shift the CRC register by a number of bits, feeding zeros.
+  * @param  [in] crc:  The CRC register.
+  * @param  [in] bits: The number of bits to shift.
+  * @return The shifted CRC register.
+  */
+static constexpr uint16_t crc16Shift(uint16_t crc, uint32_t bits)
+{
+  return bits == 0 ? crc :
+         crc16Shift((crc & 0x8000) ? (uint16_t)((crc << 1) ^ CRC16_POLYNOMIAL) : (uint16_t)(crc << 1), bits - 1);
+}
+
+/**
+  * @brief  Calculate one entry of the byte-wise lookup table.
+  * @param  [in] n: The table index.
+  * @return CRC16 of the single byte @n.
+  */
+static constexpr uint16_t crc16Entry(uint32_t n)
+{
+  return crc16Shift((uint16_t)(n << 8), 8);
+}
+
+/**
+  * @brief  Calculate one entry of the slice-by-N lookup tables.
+  * @param  [in] k: The slice index, the number of zero bytes following @n.
+  * @param  [in] n: The table index.
+  * @return CRC16 of the byte @n followed by @k zero bytes.
+  */
+static constexpr uint16_t crc16Slice(uint32_t k, uint32_t n)
+{
+  return crc16Power(crc16Entry(n), k);
+}
+
+/**
+  * @brief  Multiply the CRC register by x^(8 * bytes) modulo the polynomial.
+  * @param  [in] crc:   The CRC register.
+  * @param  [in] bytes: The number of zero bytes to feed.
+  * @return The CRC register after @bytes zero bytes.
+  */
+static constexpr uint16_t crc16Power(uint16_t crc, uint32_t bytes)
+{
+  return bytes == 0 ? crc : crc16Power(crc16Shift(crc, 8), bytes - 1);
+}
+
+/* Variable definitions ------------------------------------------------------*/
+static constexpr uint16_t crc16Tables[CRC16_SLICE][256] =
+{
+  CRC16_TABLE_256(0), CRC16_TABLE_256(1), CRC16_TABLE_256(2), CRC16_TABLE_256(3),
+  CRC16_TABLE_256(4), CRC16_TABLE_256(5), CRC16_TABLE_256(6), CRC16_TABLE_256(7)
+};
+
+#ifdef CRC16_CLMUL
+/* Folding constants x^n mod P, a 128-bit block is folded across 1 or 4 blocks. */
+static constexpr uint16_t crc16FoldHigh1 = crc16Power(1, 24);
+static constexpr uint16_t crc16FoldLow1  = crc16Power(1, 16);
+static constexpr uint16_t crc16FoldHigh4 = crc16Power(1, 72);
+static constexpr uint16_t crc16FoldLow4  = crc16Power(1, 64);
+
+static const bool crc16ClmulSupported = crc16ClmulDetect();
+#endif
+
+/**
+  * @brief  Calculate CRC16 checksum bit by bit.
+  * @param  [in] crc:  The initial CRC value.
+  * @param  [in] buff: The data to be calculated.
+  * @param  [in] len:  The length of the data to be calculated.
+  * @return Calculated CRC16 checksum.
+  */
+uint16_t crc16Bitwise(uint16_t crc, const uint8_t *buff, uint32_t len)
+{
+  while(len--)
+  {
+    crc ^= (uint16_t)(*(buff++)) << 8;
+
+    for(int i = 0; i < 8; i++)
+    {
+      if(crc & 0x8000)
+      {
+        crc = (crc << 1) ^ CRC16_POLYNOMIAL;
+      }
+      else
+      {
+        crc = crc << 1;
+      }
+    }
+  }
+
+  return crc;
+}
+
+/**
+  * @brief  Calculate CRC16 checksum one byte per table lookup.
+  * @param  [in] crc:  The initial CRC value.
+  * @param  [in] buff: The data to be calculated.
+  * @param  [in] len:  The length of the data to be calculated.
+  * @return Calculated CRC16 checksum.
+  */
+uint16_t crc16Table(uint16_t crc, const uint8_t *buff, uint32_t len)
+{
+  while(len--)
+  {
+    crc = (uint16_t)(crc << 8) ^ crc16Tables[0][(uint8_t)(crc >> 8) ^ *(buff++)];
+  }
+
+  return crc;
+}
+
+/**
+  * @brief  Calculate CRC16 checksum eight bytes per iteration.
+  * @param  [in] crc:  The initial CRC value.
+  * @param  [in] buff: The data to be calculated.
+  * @param  [in] len:  The length of the data to be calculated.
+  * @return Calculated CRC16 checksum.
+  */
+uint16_t crc16Slice8(uint16_t crc, const uint8_t *buff, uint32_t len)
+{
+  while(len >= CRC16_SLICE)
+  {
+    crc ^= ((uint16_t)(buff[0]) << 8) | buff[1];
+
+    crc = crc16Tables[7][crc >> 8]     ^ crc16Tables[6][crc & 0xFF] ^
+          crc16Tables[5][buff[2]]      ^ crc16Tables[4][buff[3]]    ^
+          crc16Tables[3][buff[4]]      ^ crc16Tables[2][buff[5]]    ^
+          crc16Tables[1][buff[6]]      ^ crc16Tables[0][buff[7]];
+
+    buff += CRC16_SLICE;
+    len  -= CRC16_SLICE;
+  }
+
+  return crc16Table(crc, buff, len);
+}
+
+#ifdef CRC16_CLMUL
+/**
+  * @brief  Check whether the CPU supports the carry-less multiplication kernel.
+  * @param  None.
+  * @return True if PCLMULQDQ and SSSE3 are available.
+  */
+static bool crc16ClmulDetect()
+{
+  int info[4] = {0};
+
+#ifdef _MSC_VER
+  __cpuid(info, 1);
+#else
+  unsigned int eax, ebx, ecx, edx;
+
+  if(__get_cpuid(1, &eax, &ebx, &ecx, &edx) == 0)
+  {
+    return false;
+  }
+
+  info[2] = (int)(ecx);
+#endif
+
+  return ((info[2] & (1 << 1)) != 0) && ((info[2] & (1 << 9)) != 0);
+}
+
+/**
+  * @brief  Fold a 128-bit accumulator forward and add the next block.
+  * @param  [in] acc:   The accumulator, bit i is the coefficient of x^i.
+  * @param  [in] fold:  The folding constants, high and low qword.
+  * @param  [in] block: The next block in the same bit order.
+  * @return The folded accumulator.
+  */
+CRC16_CLMUL_TARGET
+static inline __m128i crc16ClmulFold(__m128i acc, __m128i fold, __m128i block)
+{
+  return _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(acc, fold, 0x11),
+                                     _mm_clmulepi64_si128(acc, fold, 0x00)), block);
+}
+
+/**
+  * @brief  Calculate CRC16 checksum by folding 16-byte blocks with carry-less multiplication.
+  * @param  [in] crc:  The initial CRC value.
+  * @param  [in] buff: The data to be calculated.
+  * @param  [in] len:  The length of the data to be calculated.
+  * @note   The message is reduced to a 128-bit remainder congruent to it modulo
+  *         the polynomial, which is then finished with the table engine.
+  * @return Calculated CRC16 checksum.
+  */
+CRC16_CLMUL_TARGET
+static uint16_t crc16ClmulKernel(uint16_t crc, const uint8_t *buff, uint32_t len)
+{
+  const __m128i swap  = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+  const __m128i fold1 = _mm_set_epi64x(crc16FoldHigh1, crc16FoldLow1);
+  const __m128i fold4 = _mm_set_epi64x(crc16FoldHigh4, crc16FoldLow4);
+
+  uint32_t blocks = len / CRC16_CLMUL_BLOCK;
+  uint8_t  remainder[CRC16_CLMUL_BLOCK];
+
+  __m128i acc0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(buff + 0)), swap);
+  __m128i acc1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(buff + 16)), swap);
+  __m128i acc2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(buff + 32)), swap);
+  __m128i acc3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(buff + 48)), swap);
+
+  acc0    = _mm_xor_si128(acc0, _mm_set_epi64x((int64_t)((uint64_t)(crc) << 48), 0));
+  buff   += 4 * CRC16_CLMUL_BLOCK;
+  blocks -= 4;
+
+  while(blocks >= 4)
+  {
+    acc0 = crc16ClmulFold(acc0, fold4, _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(buff + 0)), swap));
+    acc1 = crc16ClmulFold(acc1, fold4, _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(buff + 16)), swap));
+    acc2 = crc16ClmulFold(acc2, fold4, _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(buff + 32)), swap));
+    acc3 = crc16ClmulFold(acc3, fold4, _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(buff + 48)), swap));
+
+    buff   += 4 * CRC16_CLMUL_BLOCK;
+    blocks -= 4;
+  }
+
+  acc0 = crc16ClmulFold(acc0, fold1, acc1);
+  acc0 = crc16ClmulFold(acc0, fold1, acc2);
+  acc0 = crc16ClmulFold(acc0, fold1, acc3);
+
+  while(blocks > 0)
+  {
+    acc0 = crc16ClmulFold(acc0, fold1, _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(buff)), swap));
+
+    buff   += CRC16_CLMUL_BLOCK;
+    blocks -= 1;
+  }
+
+  _mm_storeu_si128((__m128i *)(remainder), _mm_shuffle_epi8(acc0, swap));
+
+  crc = crc16Slice8(0, remainder, CRC16_CLMUL_BLOCK);
+
+  return crc16Slice8(crc, buff, len % CRC16_CLMUL_BLOCK);
+}
+#endif
+
+/**
+  * @brief  Calculate CRC16 checksum with carry-less multiplication.
+  * @param  [in] crc:  The initial CRC value.
+  * @param  [in] buff: The data to be calculated.
+  * @param  [in] len:  The length of the data to be calculated.
+  * @note   Falls back to slice-by-8 on short data and on CPUs without PCLMULQDQ.
+  * @return Calculated CRC16 checksum.
+  */
+uint16_t crc16Clmul(uint16_t crc, const uint8_t *buff, uint32_t len)
+{
+#ifdef CRC16_CLMUL
+  if((len >= CRC16_CLMUL_MIN) && (crc16ClmulSupported == true))
+  {
+    return crc16ClmulKernel(crc, buff, len);
+  }
+#endif
+
+  return crc16Slice8(crc, buff, len);
+}
+
+/**
+  * @brief  Calculate CRC16 checksum with the selected engine.
+  * @param  [in] engine: The engine to be used.
+  * @param  [in] crc:    The initial CRC value.
+  * @param  [in] buff:   The data to be calculated.
+  * @param  [in] len:    The length of the data to be calculated.
+  * @return Calculated CRC16 checksum.
+  */
+uint16_t crc16(Crc16Engine engine, uint16_t crc, const uint8_t *buff, uint32_t len)
+{
+  switch(engine)
+  {
+    case Crc16EngineBitwise:
+    {
+      return crc16Bitwise(crc, buff, len);
+    }
+
+    case Crc16EngineTable:
+    {
+      return crc16Table(crc, buff, len);
+    }
+
+    case Crc16EngineSlice8:
+    {
+      return crc16Slice8(crc, buff, len);
+    }
+
+    case Crc16EngineClmul:
+    {
+      return crc16Clmul(crc, buff, len);
+    }
+
+    default:
+    {
+      return crc16(crc16Best(), crc, buff, len);
+    }
+  }
+}
+
+/**
+  * @brief  Get the fastest engine supported by this machine.
+  * @param  None.
+  * @return The fastest engine.
+  */
+Crc16Engine crc16Best()
+{
+#ifdef CRC16_CLMUL
+  if(crc16ClmulSupported == true)
+  {
+    return Crc16EngineClmul;
+  }
+#endif
+
+  return Crc16EngineSlice8;
+}
+
+/**
+  * @brief  Check whether an engine is supported by this machine.
+  * @param  [in] engine: The engine to be checked.
+  * @return True if the engine can be used.
+  */
+bool crc16Supported(Crc16Engine engine)
+{
+  switch(engine)
+  {
+    case Crc16EngineAuto:
+    case Crc16EngineBitwise:
+    case Crc16EngineTable:
+    case Crc16EngineSlice8:
+    {
+      return true;
+    }
+
+#ifdef CRC16_CLMUL
+    case Crc16EngineClmul:
+    {
+      return crc16ClmulSupported;
+    }
+#endif
+
+    default:
+    {
+      return false;
+    }
+  }
+}
+
+/**
+  * @brief  Get the name of an engine.
+  * @param  [in] engine: The engine.
+  * @return The name of the engine.
+  */
+const char *crc16Name(Crc16Engine engine)
+{
+  switch(engine)
+  {
+    case Crc16EngineAuto:
+    {
+      return "auto";
+    }
+
+    case Crc16EngineBitwise:
+    {
+      return "bitwise";
+    }
+
+    case Crc16EngineTable:
+    {
+      return "table";
+    }
+
+    case Crc16EngineSlice8:
+    {
+      return "slice8";
+    }
+
+    case Crc16EngineClmul:
+    {
+      return "clmul";
+    }
+
+    default:
+    {
+      return "unknown";
+    }
+  }
+}
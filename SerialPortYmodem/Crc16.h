@@ -0,0 +1,69 @@
+/**
+  ******************************************************************************
+  * @file    Crc16.h
+  * @author  SerialPortYmodem contributors
+  * @version v1.0
+  * @date    16-October-2026
+  * @brief   Header file for Crc16.cpp module.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>Copyright &copy; 2026 SerialPortYmodem contributors</center></h2>
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#ifndef __CRC16_H
+#define __CRC16_H
+
+/* Header includes -----------------------------------------------------------*/
+#include <stdint.h>
+
+/* Macro definitions ---------------------------------------------------------*/
+#define CRC16_POLYNOMIAL  (0x1021)
+#define CRC16_SLICE       (8)
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define CRC16_CLMUL
+#endif
+
+/* Type definitions ----------------------------------------------------------*/
+enum Crc16Engine
+{
+  Crc16EngineAuto,
+  Crc16EngineBitwise,
+  Crc16EngineTable,
+  Crc16EngineSlice8,
+  Crc16EngineClmul
+};
+
+/* Variable declarations -----------------------------------------------------*/
+/* Variable definitions ------------------------------------------------------*/
+
+/* Function declarations -----------------------------------------------------*/
+uint16_t crc16Bitwise(uint16_t crc, const uint8_t *buff, uint32_t len);
+uint16_t crc16Table(uint16_t crc, const uint8_t *buff, uint32_t len);
+uint16_t crc16Slice8(uint16_t crc, const uint8_t *buff, uint32_t len);
+uint16_t crc16Clmul(uint16_t crc, const uint8_t *buff, uint32_t len);
+
+uint16_t crc16(Crc16Engine engine, uint16_t crc, const uint8_t *buff, uint32_t len);
+Crc16Engine crc16Best();
+bool crc16Supported(Crc16Engine engine);
+const char *crc16Name(Crc16Engine engine);
+
+/* Function definitions ------------------------------------------------------*/
+
+#endif /* __CRC16_H */
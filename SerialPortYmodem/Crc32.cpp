@@ -0,0 +1,126 @@
+/**
+  ******************************************************************************
+  * @file    Crc32.cpp
+  * @author  SerialPortYmodem contributors
+  * @version v1.0
+  * @date    16-October-2026
+  * @brief   CRC-32 (IEEE 802.3) module source file.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>Copyright &copy; 2026 SerialPortYmodem contributors</center></h2>
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+/* Header includes -----------------------------------------------------------*/
+#include "Crc32.h"
+
+/* Macro definitions ---------------------------------------------------------*/
+#define CRC32_TABLE_4(k, n)    crc32Slice(k, (n) + 0),  crc32Slice(k, (n) + 1),   \
+                               crc32Slice(k, (n) + 2),  crc32Slice(k, (n) + 3)
+#define CRC32_TABLE_16(k, n)   CRC32_TABLE_4(k, (n) + 0),  CRC32_TABLE_4(k, (n) + 4),   \
+                               CRC32_TABLE_4(k, (n) + 8),  CRC32_TABLE_4(k, (n) + 12)
+#define CRC32_TABLE_64(k, n)   CRC32_TABLE_16(k, (n) + 0), CRC32_TABLE_16(k, (n) + 16), \
+                               CRC32_TABLE_16(k, (n) + 32), CRC32_TABLE_16(k, (n) + 48)
+#define CRC32_TABLE_256(k)     { CRC32_TABLE_64(k, 0),  CRC32_TABLE_64(k, 64),           \
+                                 CRC32_TABLE_64(k, 128), CRC32_TABLE_64(k, 192) }
+
+/* Type definitions ----------------------------------------------------------*/
+/* Variable declarations -----------------------------------------------------*/
+
+/* Function declarations -----------------------------------------------------*/
+static constexpr uint32_t crc32Shift(uint32_t crc, uint32_t bits);
+static constexpr uint32_t crc32Entry(uint32_t n);
+static constexpr uint32_t crc32Slice(uint32_t k, uint32_t n);
+
+/* Function definitions ------------------------------------------------------*/
+
+/**
+  * @brief  Shift the reflected CRC register by a number of bits, feeding zeros.
+  * @param  [in] crc:  The CRC register.
+  * @param  [in] bits: The number of bits to shift.
+  * @return The shifted CRC register.
+  */
+static constexpr uint32_t crc32Shift(uint32_t crc, uint32_t bits)
+{
+  return bits == 0 ? crc : crc32Shift((crc & 1) ? ((crc >> 1) ^ CRC32_POLYNOMIAL) : (crc >> 1), bits - 1);
+}
+
+/**
+  * @brief  Calculate one entry of the byte-wise lookup table.
+  * @param  [in] n: The table index.
+  * @return CRC32 register of the single byte @n.
+  */
+static constexpr uint32_t crc32Entry(uint32_t n)
+{
+  return crc32Shift(n, 8);
+}
+
+/**
+  * @brief  Calculate one entry of the slice-by-N lookup tables.
+  * @param  [in] k: The slice index, the number of zero bytes following @n.
+  * @param  [in] n: The table index.
+  * @return CRC32 register of the byte @n followed by @k zero bytes.
+  */
+static constexpr uint32_t crc32Slice(uint32_t k, uint32_t n)
+{
+  return k == 0 ? crc32Entry(n) : crc32Shift(crc32Slice(k - 1, n), 8);
+}
+
+/* Variable definitions ------------------------------------------------------*/
+static constexpr uint32_t crc32Tables[CRC32_SLICE][256] =
+{
+  CRC32_TABLE_256(0), CRC32_TABLE_256(1), CRC32_TABLE_256(2), CRC32_TABLE_256(3),
+  CRC32_TABLE_256(4), CRC32_TABLE_256(5), CRC32_TABLE_256(6), CRC32_TABLE_256(7)
+};
+
+/**
+  * @brief  Calculate CRC32 checksum eight bytes per iteration.
+  * @param  [in] crc:  The CRC32 of the preceding data, 0 for the first call.
+  * @param  [in] buff: The data to be calculated.
+  * @param  [in] len:  The length of the data to be calculated.
+  * @note   The result is the same as zlib's crc32(), so the calculation can be split
+  *         across calls by passing the previous result as @crc.
+  * @return Calculated CRC32 checksum.
+  */
+uint32_t crc32Slice8(uint32_t crc, const uint8_t *buff, uint32_t len)
+{
+  crc = ~crc;
+
+  while(len >= CRC32_SLICE)
+  {
+    uint32_t low  = crc ^ (((uint32_t)(buff[0]) << 0)  | ((uint32_t)(buff[1]) << 8) |
+                           ((uint32_t)(buff[2]) << 16) | ((uint32_t)(buff[3]) << 24));
+    uint32_t high =        (((uint32_t)(buff[4]) << 0)  | ((uint32_t)(buff[5]) << 8) |
+                           ((uint32_t)(buff[6]) << 16) | ((uint32_t)(buff[7]) << 24));
+
+    crc = crc32Tables[7][(low  >> 0) & 0xFF] ^ crc32Tables[6][(low  >> 8) & 0xFF] ^
+          crc32Tables[5][(low  >> 16) & 0xFF] ^ crc32Tables[4][(low  >> 24) & 0xFF] ^
+          crc32Tables[3][(high >> 0) & 0xFF] ^ crc32Tables[2][(high >> 8) & 0xFF] ^
+          crc32Tables[1][(high >> 16) & 0xFF] ^ crc32Tables[0][(high >> 24) & 0xFF];
+
+    buff += CRC32_SLICE;
+    len  -= CRC32_SLICE;
+  }
+
+  while(len--)
+  {
+    crc = (crc >> 8) ^ crc32Tables[0][(crc ^ *(buff++)) & 0xFF];
+  }
+
+  return ~crc;
+}
@@ -0,0 +1,48 @@
+/**
+  ******************************************************************************
+  * @file    Crc32.h
+  * @author  SerialPortYmodem contributors
+  * @version v1.0
+  * @date    16-October-2026
+  * @brief   Header file for Crc32.cpp module.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>Copyright &copy; 2026 SerialPortYmodem contributors</center></h2>
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#ifndef __CRC32_H
+#define __CRC32_H
+
+/* Header includes -----------------------------------------------------------*/
+#include <stdint.h>
+
+/* Macro definitions ---------------------------------------------------------*/
+#define CRC32_POLYNOMIAL  (0xEDB88320)
+#define CRC32_SLICE       (8)
+
+/* Type definitions ----------------------------------------------------------*/
+/* Variable declarations -----------------------------------------------------*/
+/* Variable definitions ------------------------------------------------------*/
+
+/* Function declarations -----------------------------------------------------*/
+uint32_t crc32Slice8(uint32_t crc, const uint8_t *buff, uint32_t len);
+
+/* Function definitions ------------------------------------------------------*/
+
+#endif /* __CRC32_H */
@@ -28,12 +28,27 @@ SOURCES += main.cpp\
         widget.cpp \
     YmodemFileReceive.cpp \
     Ymodem.cpp \
-    YmodemFileTransmit.cpp
+    YmodemFileTransmit.cpp \
+    Crc16.cpp \
+    Crc32.cpp \
+    YmodemFileSource.cpp \
+    YmodemFileSink.cpp \
+    YmodemCompress.cpp \
+    YmodemDelta.cpp \
+    YmodemTransferManager.cpp
 
 HEADERS  += widget.h \
     Ymodem.h \
+    YmodemCore.h \
     YmodemFileReceive.h \
-    YmodemFileTransmit.h
+    YmodemFileTransmit.h \
+    Crc16.h \
+    Crc32.h \
+    YmodemFileSource.h \
+    YmodemFileSink.h \
+    YmodemCompress.h \
+    YmodemDelta.h \
+    YmodemTransferManager.h
 
 FORMS    += widget.ui
 
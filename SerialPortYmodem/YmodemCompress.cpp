@@ -0,0 +1,157 @@
+/**
+  ******************************************************************************
+  * @file    YmodemCompress.cpp
+  * @author  SerialPortYmodem contributors
+  * @version v1.0
+  * @date    17-October-2026
+  * @brief   Streaming compression of the transferred data.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>Copyright &copy; 2026 SerialPortYmodem contributors</center></h2>
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#include "YmodemCompress.h"
+#include "Crc32.h"
+#include <QtEndian>
+#include <string.h>
+
+#define COMPRESS_HEADER_SIZE  (12)
+#define COMPRESS_FLAG         (0x80000000UL)
+
+YmodemCompressEncoder::YmodemCompressEncoder() :
+    position(0)
+{
+}
+
+void YmodemCompressEncoder::reset()
+{
+    buffer.clear();
+
+    position = 0;
+}
+
+void YmodemCompressEncoder::encode(const char *data, int size)
+{
+    QByteArray packed     = qCompress((const uchar *)data, size);
+    bool       compressed = packed.size() < size;
+    int        length     = (compressed == true) ? packed.size() : size;
+    uchar      header[COMPRESS_HEADER_SIZE];
+
+    qToBigEndian<quint32>(size | ((compressed == true) ? COMPRESS_FLAG : 0), &(header[0]));
+    qToBigEndian<quint32>(length, &(header[4]));
+    qToBigEndian<quint32>(crc32Slice8(0, (const uint8_t *)data, size), &(header[8]));
+
+    buffer.append((const char *)header, COMPRESS_HEADER_SIZE);
+    buffer.append((compressed == true) ? packed.constData() : data, length);
+}
+
+int YmodemCompressEncoder::available() const
+{
+    return buffer.size() - position;
+}
+
+int YmodemCompressEncoder::take(char *data, int maxSize)
+{
+    int size = qMin(maxSize, available());
+
+    memcpy(data, buffer.constData() + position, size);
+
+    position += size;
+
+    if(position == buffer.size())
+    {
+        buffer.clear();
+
+        position = 0;
+    }
+    else if(position >= COMPRESS_CHUNK_SIZE)
+    {
+        buffer.remove(0, position);
+
+        position = 0;
+    }
+
+    return size;
+}
+
+YmodemCompressDecoder::YmodemCompressDecoder() :
+    remain(0)
+{
+}
+
+void YmodemCompressDecoder::reset(quint64 size)
+{
+    buffer.clear();
+
+    remain = size;
+}
+
+bool YmodemCompressDecoder::decode(const char *data, int size, QByteArray *output)
+{
+    /* The bytes after the last chunk are only the padding of the last packet. */
+    if(remain == 0)
+    {
+        return true;
+    }
+
+    buffer.append(data, size);
+
+    while(buffer.size() >= COMPRESS_HEADER_SIZE)
+    {
+        const uchar *header     = (const uchar *)buffer.constData();
+        quint32      original   = qFromBigEndian<quint32>(&(header[0])) & ~COMPRESS_FLAG;
+        bool         compressed = (qFromBigEndian<quint32>(&(header[0])) & COMPRESS_FLAG) != 0;
+        quint32      length     = qFromBigEndian<quint32>(&(header[4]));
+        quint32      crc        = qFromBigEndian<quint32>(&(header[8]));
+
+        if((original == 0) || (original > COMPRESS_CHUNK_SIZE) || (original > remain) ||
+           ((compressed == true) ? (length >= original) : (length != original)))
+        {
+            return false;
+        }
+
+        if((quint32)(buffer.size() - COMPRESS_HEADER_SIZE) < length)
+        {
+            break;
+        }
+
+        QByteArray chunk = (compressed == true) ? qUncompress(&(header[COMPRESS_HEADER_SIZE]), length) :
+                                                  QByteArray((const char *)&(header[COMPRESS_HEADER_SIZE]), length);
+
+        if(((quint32)(chunk.size()) != original) ||
+           (crc32Slice8(0, (const uint8_t *)chunk.constData(), original) != crc))
+        {
+            return false;
+        }
+
+        output->append(chunk);
+        buffer.remove(0, COMPRESS_HEADER_SIZE + length);
+
+        remain -= original;
+
+        if(remain == 0)
+        {
+            buffer.clear();
+
+            break;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,71 @@
+/**
+  ******************************************************************************
+  * @file    YmodemCompress.h
+  * @author  SerialPortYmodem contributors
+  * @version v1.0
+  * @date    17-October-2026
+  * @brief   Header file for YmodemCompress.cpp module.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>Copyright &copy; 2026 SerialPortYmodem contributors</center></h2>
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#ifndef YMODEMCOMPRESS_H
+#define YMODEMCOMPRESS_H
+
+#include <QByteArray>
+
+#define COMPRESS_CHUNK_SIZE  (64 * 1024)
+
+/*
+ * The data stream of an OptionCompress session is a sequence of chunks, each holding up to
+ * COMPRESS_CHUNK_SIZE bytes of the file behind a 12-byte big-endian header: the original
+ * length with the top bit set when the payload is compressed, the payload length and the
+ * CRC32 of the original bytes. A chunk that does not shrink is sent raw.
+ */
+class YmodemCompressEncoder
+{
+public:
+    YmodemCompressEncoder();
+
+    void reset();
+    void encode(const char *data, int size);
+
+    int available() const;
+    int take(char *data, int maxSize);
+
+private:
+    QByteArray buffer;
+    int        position;
+};
+
+class YmodemCompressDecoder
+{
+public:
+    YmodemCompressDecoder();
+
+    void reset(quint64 size);
+    bool decode(const char *data, int size, QByteArray *output);
+
+private:
+    QByteArray buffer;
+    quint64    remain;
+};
+
+#endif // YMODEMCOMPRESS_H
@@ -0,0 +1,4480 @@
+/**
+  ******************************************************************************
+  * @file    YmodemCore.h
+  * @author  XinLi
+  * @version v1.0
+  * @date    21-January-2018
+  * @brief   Header-only ymodem protocol core.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>Copyright &copy; 2018 XinLi</center></h2>
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#ifndef __YMODEM_CORE_H
+#define __YMODEM_CORE_H
+
+/* Header includes -----------------------------------------------------------*/
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include "Crc16.h"
+#include "Crc32.h"
+
+/* Macro definitions ---------------------------------------------------------*/
+#define YMODEM_PACKET_HEADER    (3)
+#define YMODEM_PACKET_TRAILER   (2)
+#define YMODEM_PACKET_OVERHEAD  (YMODEM_PACKET_HEADER + YMODEM_PACKET_TRAILER)
+#define YMODEM_PACKET_SIZE      (128)
+#define YMODEM_PACKET_1K_SIZE   (1024)
+
+#define YMODEM_PACKET_EXT_TRAILER   (4)
+#define YMODEM_PACKET_EXT_OVERHEAD  (YMODEM_PACKET_HEADER + YMODEM_PACKET_EXT_TRAILER)
+#define YMODEM_PACKET_EXT_SIZE      (32768)
+
+#define YMODEM_CODE_CAN_NUMBER  (5)
+
+#define YMODEM_WINDOW_SIZE      (8)
+
+#define YMODEM_RESUME_SIZE      (8)
+
+#define YMODEM_RTT_BUCKETS      (240)
+
+#define YMODEM_ADAPT_PERIOD     (8)
+#define YMODEM_ADAPT_WEIGHT     (16)
+#define YMODEM_ADAPT_TURNAROUND (16)
+#define YMODEM_ADAPT_CLEAN      (1024)
+
+#define YMODEM_OPTION_MARK          (0x80)
+#define YMODEM_OPTION_NEGOTIATED    (YmodemBase::OptionWindow | YmodemBase::OptionExtended | YmodemBase::OptionResume | \
+                                     YmodemBase::OptionCompress | YmodemBase::OptionDelta)
+
+#define YMODEM_WINDOW_SLOT(number)  ((uint8_t)(number) & (YMODEM_WINDOW_SIZE - 1))
+#define YMODEM_WINDOW_BIT(number)   (1UL << YMODEM_WINDOW_SLOT(number))
+
+#define YMODEM_RESUME_TAG           (0x40)
+#define YMODEM_RESUME_POSITION      (YMODEM_PACKET_SIZE - 2 - YMODEM_RESUME_SIZE)
+#define YMODEM_RESUME_FRAME         (2 + YMODEM_RESUME_SIZE + YMODEM_PACKET_TRAILER)
+
+#define YMODEM_RTT_IDLE             (0)
+#define YMODEM_RTT_TIMED            (1)
+#define YMODEM_RTT_RESENT           (2)
+
+#define YMODEM_CORE_TEMPLATE        template<uint32_t BlockSize, class Checksum, bool Batch, class Transport>
+#define YMODEM_CORE                 YmodemCore<BlockSize, Checksum, Batch, Transport>
+
+/* Type definitions ----------------------------------------------------------*/
+class YmodemBase
+{
+public:
+  enum Code
+  {
+    CodeNone = 0x00,
+    CodeSoh  = 0x01,
+    CodeStx  = 0x02,
+    CodeEtx  = 0x03,
+    CodeEot  = 0x04,
+    CodeAck  = 0x06,
+    CodeNak  = 0x15,
+    CodeCan  = 0x18,
+    CodeC    = 0x43,
+    CodeG    = 0x47,
+    CodeX    = 0x58,
+    CodeA1   = 0x41,
+    CodeA2   = 0x61
+  };
+
+  enum Stage
+  {
+    StageNone,
+    StageEstablishing,
+    StageEstablished,
+    StageTransmitting,
+    StageFinishing,
+    StageFinished
+  };
+
+  enum Status
+  {
+    StatusEstablish,
+    StatusTransmit,
+    StatusFinish,
+    StatusAbort,
+    StatusTimeout,
+    StatusError,
+    StatusResume
+  };
+
+  enum Option
+  {
+    OptionNone      = 0x00,
+    OptionStreaming = 0x01,
+    OptionWindow    = 0x02,
+    OptionExtended  = 0x04,
+    OptionResume    = 0x08,
+    OptionCompress  = 0x10,
+    OptionDelta     = 0x20
+  };
+
+  struct Stats
+  {
+    uint32_t packetsSent;     /*!< Data packets written, retransmissions included. */
+    uint32_t packets128;      /*!< Data packets of 128 bytes written. */
+    uint32_t packets1K;       /*!< Data packets of 1024 bytes written. */
+    uint32_t packetsExtended; /*!< Extended data packets written. */
+    uint32_t packetSize;      /*!< Data size chosen for the last packet built. */
+    uint32_t sizeChanges;     /*!< Changes of the data size by the adaptive packet size. */
+    uint32_t packetsReceived; /*!< Data packets read, damaged ones included. */
+    uint32_t duplicates;      /*!< Data packets received again after being accepted. */
+    uint32_t naks;            /*!< NAKs sent by the receiver or received by the transmitter. */
+    uint32_t crcErrors;       /*!< Data packets received with a wrong checksum. */
+    uint32_t timeouts;        /*!< Retransmission intervals elapsed without a response. */
+    uint32_t retries;         /*!< Same as @getRetryCount. */
+    uint32_t rttCount;        /*!< ACK round trips measured. */
+    uint32_t rttMin;          /*!< Shortest ACK round trip in microseconds. */
+    uint32_t rttAverage;      /*!< Average ACK round trip in microseconds. */
+    uint32_t rttP99;          /*!< 99th percentile ACK round trip in microseconds. */
+    uint32_t rttMax;          /*!< Longest ACK round trip in microseconds. */
+    uint32_t callbackCount;   /*!< Calls of the callback. */
+    uint64_t callbackTime;    /*!< Time spent in the callback in microseconds. */
+    uint64_t bytes;           /*!< Data bytes accepted by the callback. */
+    uint64_t elapsed;         /*!< Time since the session started in microseconds. */
+    uint64_t bytesPerSecond;  /*!< @bytes divided by @elapsed. */
+  };
+};
+
+class YmodemChecksum
+{
+public:
+  enum
+  {
+    Size = 1
+  };
+
+  static uint32_t update(Crc16Engine engine, uint32_t value, const uint8_t *buff, uint32_t len);
+  static void put(uint8_t *buff, uint32_t value);
+  static uint32_t get(const uint8_t *buff);
+};
+
+class YmodemCrc16
+{
+public:
+  enum
+  {
+    Size = 2
+  };
+
+  static uint32_t update(Crc16Engine engine, uint32_t value, const uint8_t *buff, uint32_t len);
+  static void put(uint8_t *buff, uint32_t value);
+  static uint32_t get(const uint8_t *buff);
+};
+
+class YmodemClock
+{
+public:
+  static uint32_t tick();
+  static uint64_t microTick();
+};
+
+/*
+ * BlockSize is the largest data block (128, 1024 or a multiple of 1024 for extended packets),
+ * Checksum is YmodemChecksum or YmodemCrc16 and Batch selects the ymodem header packet and
+ * the negotiated options. Transport provides callback(), read(), write(), tick() and
+ * microTick() with the signatures of YmodemTransport, they may be non-virtual.
+ */
+YMODEM_CORE_TEMPLATE
+class YmodemCore : public YmodemBase, public Transport
+{
+public:
+  YmodemCore(uint32_t timeDivide = 499, uint32_t timeMax = 5, uint32_t errorMax = 999, uint32_t timeUnit = 10);
+
+  void setTimeDivide(uint32_t timeDivide);
+  uint32_t getTimeDivide();
+
+  void setTimeMax(uint32_t timeMax);
+  uint32_t getTimeMax();
+
+  void setErrorMax(uint32_t errorMax);
+  uint32_t getErrorMax();
+
+  void setTimeUnit(uint32_t timeUnit);
+  uint32_t getTimeUnit();
+
+  void setCrcEngine(Crc16Engine crcEngine);
+  Crc16Engine getCrcEngine();
+
+  void setOptions(uint32_t options);
+  uint32_t getOptions();
+  uint32_t getSessionOptions();
+
+  void setExtendedSize(uint32_t extendedSize);
+  uint32_t getExtendedSize();
+
+  void setAdaptive(bool adaptive);
+  bool getAdaptive();
+
+  uint32_t getTimeToDeadline();
+  uint32_t getRetryCount();
+  Stats getTransferStats();
+
+  void receive();
+  void transmit();
+  void abort();
+
+private:
+  enum
+  {
+    PacketOverhead   = YMODEM_PACKET_HEADER + Checksum::Size,
+    PacketSize       = (BlockSize < YMODEM_PACKET_1K_SIZE) ? BlockSize : YMODEM_PACKET_1K_SIZE,
+    BufferSize       = BlockSize + ((BlockSize > YMODEM_PACKET_1K_SIZE) ? YMODEM_PACKET_EXT_OVERHEAD : PacketOverhead),
+    SupportedOptions = (Batch != true) ? OptionNone :
+                       (OptionStreaming | OptionWindow | OptionResume | OptionCompress | OptionDelta |
+                        ((BlockSize > YMODEM_PACKET_1K_SIZE) ? OptionExtended : OptionNone)),
+    WindowSize       = ((SupportedOptions & OptionWindow) != 0) ? YMODEM_WINDOW_SIZE : 1
+  };
+
+  static_assert((BlockSize == YMODEM_PACKET_SIZE) ||
+                (((BlockSize % YMODEM_PACKET_1K_SIZE) == 0) && (BlockSize <= YMODEM_PACKET_EXT_SIZE)),
+                "The block size must be 128, 1024 or an extended size of up to 32768 in steps of 1024.");
+  static_assert((Batch != true) || (Checksum::Size == YMODEM_PACKET_TRAILER),
+                "A batch session is always checked with CRC16.");
+
+  using Transport::callback;
+  using Transport::read;
+  using Transport::write;
+  using Transport::tick;
+  using Transport::microTick;
+
+  static uint32_t rttBucket(uint32_t rtt);
+  static uint32_t rttBucketLimit(uint32_t bucket);
+
+  bool sessionHas(uint32_t option);
+
+  Code receivePacket();
+  uint32_t receiveRequest(uint8_t *buff);
+  uint32_t receiveResponse(uint8_t *buff, Code code, uint8_t number);
+  uint32_t receiveResume(uint8_t *buff);
+  bool receiveBusy();
+  Code receiveResync();
+  void receiveLost();
+  Code receiveDamaged();
+  Code receiveData(uint32_t size);
+  void receiveDuplicate(uint32_t size);
+  void receiveHeader();
+  void receivePacketCrc(uint32_t offset, uint32_t size);
+  uint32_t packetSize(Code code);
+  uint32_t framePacket(uint8_t *buff, uint8_t number, uint32_t size);
+
+  void receiveStageNone();
+  void receiveStageEstablishing();
+  void receiveStageEstablished();
+  void receiveStageTransmitting();
+  void receiveStageFinishing();
+  void receiveStageFinished();
+  void receiveStageWindow();
+
+  void transmitStageNone();
+  void transmitStageEstablishing();
+  void transmitStageEstablished();
+  void transmitStageTransmitting();
+  void transmitStageFinishing();
+  void transmitStageFinished();
+  void transmitStageWindow();
+  void transmitFirst();
+  void transmitStart();
+  void transmitPrebuild();
+  void transmitWindowFill();
+  bool transmitCrossed();
+  uint64_t rttHalf();
+  void transmitSplit();
+  Code transmitData(uint8_t *buff, uint32_t *len);
+
+  uint32_t adaptPacketSize();
+  void adaptUpdate(uint32_t length, bool error);
+  double adaptGoodput(uint32_t size);
+
+  uint32_t send(uint8_t *buff, uint32_t len);
+  Code notify(Status status, uint8_t *buff, uint32_t *len);
+  void statsReset();
+  void statsAcknowledge(uint8_t number);
+
+  uint32_t timeUpdate();
+
+  uint16_t crc16(uint8_t *buff, uint32_t len);
+
+  uint32_t timeDivide;
+  uint32_t timeMax;
+  uint32_t errorMax;
+  uint32_t timeUnit;
+
+  Crc16Engine crcEngine;
+
+  uint32_t options;
+  uint32_t session;
+  uint32_t extendedSize;
+  uint32_t sessionSize;
+
+  bool     adaptive;
+  double   adaptRate;
+  uint32_t adaptSize;
+  uint32_t adaptCount;
+
+  uint32_t timeCount;
+  uint32_t timeStamp;
+  uint32_t errorCount;
+  uint32_t retryCount;
+  uint8_t  dataCount;
+
+  Code  code;
+  Stage stage;
+
+  uint8_t  rxBuffer[BufferSize];
+  uint8_t  txFrame[2][BufferSize];
+  uint8_t *txBuffer;
+  uint8_t *txNextBuffer;
+  uint32_t rxLength;
+  uint32_t txLength;
+  uint32_t txNextLength;
+  Code     txNextCode;
+  bool     txResent;
+  bool     txIgnored;
+  uint64_t txSendStamp;
+  uint8_t  txCarry[2 * BlockSize];
+  uint32_t txCarryOffset;
+  uint32_t txCarryLength;
+  Code     txCarryCode;
+  uint32_t rxCrc;
+  bool     rxValid;
+  uint32_t rxDiscard;
+  uint32_t rxStamp;
+  Code     rxAbort;
+  uint32_t rxAccepted;
+  uint32_t rxSkip;
+
+  uint8_t  rxWindow[WindowSize][PacketSize + PacketOverhead];
+  uint8_t  txWindow[WindowSize][PacketSize + PacketOverhead];
+  uint32_t txWindowLength[WindowSize];
+  uint32_t windowCount;
+  uint32_t windowMask;
+  uint32_t windowNak;
+  bool     windowEnd;
+
+  uint8_t  resume[YMODEM_RESUME_SIZE];
+  bool     resumePending;
+
+  Stats    stats;
+  uint64_t statsStart;
+  uint64_t statsStop;
+  uint64_t rttSum;
+  uint32_t rttHistogram[YMODEM_RTT_BUCKETS];
+  uint64_t rttStamp[YMODEM_WINDOW_SIZE];
+  uint8_t  rttNumber[YMODEM_WINDOW_SIZE];
+  uint8_t  rttState[YMODEM_WINDOW_SIZE];
+};
+
+template<class Transport> using XmodemCore    = YmodemCore<YMODEM_PACKET_SIZE, YmodemChecksum, false, Transport>;
+template<class Transport> using XmodemCrcCore = YmodemCore<YMODEM_PACKET_SIZE, YmodemCrc16, false, Transport>;
+template<class Transport> using Xmodem1kCore  = YmodemCore<YMODEM_PACKET_1K_SIZE, YmodemCrc16, false, Transport>;
+template<class Transport> using Ymodem1kCore  = YmodemCore<YMODEM_PACKET_1K_SIZE, YmodemCrc16, true, Transport>;
+
+/* Variable declarations -----------------------------------------------------*/
+/* Variable definitions ------------------------------------------------------*/
+/* Function declarations -----------------------------------------------------*/
+/* Function definitions ------------------------------------------------------*/
+
+/**
+  * @brief  Update the 8-bit arithmetic checksum of XMODEM.
+  * @param  [in] engine: Not used, the checksum has no engines.
+  * @param  [in] value:  The checksum of the data before @buff.
+  * @param  [in] buff:   The data to be calculated.
+  * @param  [in] len:    The length of the data to be calculated.
+  * @return The checksum.
+  */
+inline uint32_t YmodemChecksum::update(Crc16Engine engine, uint32_t value, const uint8_t *buff, uint32_t len)
+{
+  (void)(engine);
+
+  for(uint32_t i = 0; i < len; i++)
+  {
+    value += buff[i];
+  }
+
+  return value & 0xFF;
+}
+
+/**
+  * @brief  Store the checksum in the trailer of a packet.
+  * @param  [out] buff:  The trailer.
+  * @param  [in]  value: The checksum.
+  * @return None.
+  */
+inline void YmodemChecksum::put(uint8_t *buff, uint32_t value)
+{
+  buff[0] = (uint8_t)(value);
+}
+
+/**
+  * @brief  Load the checksum from the trailer of a packet.
+  * @param  [in] buff: The trailer.
+  * @return The checksum.
+  */
+inline uint32_t YmodemChecksum::get(const uint8_t *buff)
+{
+  return buff[0];
+}
+
+/**
+  * @brief  Update the CRC16 checksum of XMODEM-CRC and YMODEM.
+  * @param  [in] engine: The engine used to calculate CRC16 checksum.
+  * @param  [in] value:  The checksum of the data before @buff.
+  * @param  [in] buff:   The data to be calculated.
+  * @param  [in] len:    The length of the data to be calculated.
+  * @return The checksum.
+  */
+inline uint32_t YmodemCrc16::update(Crc16Engine engine, uint32_t value, const uint8_t *buff, uint32_t len)
+{
+  return ::crc16(engine, (uint16_t)(value), buff, len);
+}
+
+/**
+  * @brief  Store the checksum in the trailer of a packet.
+  * @param  [out] buff:  The trailer.
+  * @param  [in]  value: The checksum.
+  * @return None.
+  */
+inline void YmodemCrc16::put(uint8_t *buff, uint32_t value)
+{
+  buff[0] = (uint8_t)(value >> 8);
+  buff[1] = (uint8_t)(value >> 0);
+}
+
+/**
+  * @brief  Load the checksum from the trailer of a packet.
+  * @param  [in] buff: The trailer.
+  * @return The checksum.
+  */
+inline uint32_t YmodemCrc16::get(const uint8_t *buff)
+{
+  return ((uint32_t)(buff[0]) << 8) | ((uint32_t)(buff[1]) << 0);
+}
+
+/**
+  * @brief  Get the monotonic clock.
+  * @param  None.
+  * @return The monotonic clock in milliseconds.
+  */
+inline uint32_t YmodemClock::tick()
+{
+  return (uint32_t)(std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+/**
+  * @brief  Get the monotonic clock used for the statistics.
+  * @param  None.
+  * @return The monotonic clock in microseconds.
+  */
+inline uint64_t YmodemClock::microTick()
+{
+  return (uint64_t)(std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+/**
+  * @brief  Get the histogram bucket of a round trip.
+  * @param  [in] rtt: The round trip in microseconds.
+  * @note   Values below 16 have a bucket each, above that every octave is split into
+  *         8 buckets, so a percentile read from the histogram is within 12.5%.
+  * @return The bucket, less than @YMODEM_RTT_BUCKETS.
+  */
+YMODEM_CORE_TEMPLATE
+uint32_t YMODEM_CORE::rttBucket(uint32_t rtt)
+{
+  uint32_t shift = 0;
+
+  while((rtt >> shift) > 15)
+  {
+    shift++;
+  }
+
+  return 8 * shift + (rtt >> shift);
+}
+
+/**
+  * @brief  Get the largest round trip that falls in a histogram bucket.
+  * @param  [in] bucket: The bucket.
+  * @return The round trip in microseconds.
+  */
+YMODEM_CORE_TEMPLATE
+uint32_t YMODEM_CORE::rttBucketLimit(uint32_t bucket)
+{
+  if(bucket < 16)
+  {
+    return bucket;
+  }
+
+  uint32_t shift = bucket / 8 - 1;
+
+  return (uint32_t)((((uint64_t)(bucket - 8 * shift) + 1) << shift) - 1);
+}
+
+/**
+  * @brief  Ymodem core constructor.
+  * @param  [in] timeDivide: The fractional factor of the time the ymodem is called.
+  * @param  [in] timeMax:    The maximum time when calling the ymodem.
+  * @param  [in] errorMax:   The maximum error count when calling the ymodem.
+  * @param  [in] timeUnit:   The time unit in milliseconds.
+  * @note   The retransmission interval = @timeUnit * (@timeDivide + 1) milliseconds.
+  *         The longest waiting time = @timeUnit * (@timeDivide + 1) * (@timeMax + 1) milliseconds.
+  * @return None.
+  */
+YMODEM_CORE_TEMPLATE
+YMODEM_CORE::YmodemCore(uint32_t timeDivide, uint32_t timeMax, uint32_t errorMax, uint32_t timeUnit)
+{
+  this->timeDivide = timeDivide;
+  this->timeMax    = timeMax;
+  this->errorMax   = errorMax;
+  this->timeUnit   = timeUnit;
+
+  this->crcEngine  = Crc16EngineAuto;
+
+  this->options      = OptionNone;
+  this->session      = OptionNone;
+  this->extendedSize = (BlockSize < 8192) ? BlockSize : 8192;
+  this->sessionSize  = YMODEM_PACKET_1K_SIZE;
+
+  this->adaptive   = true;
+  this->adaptRate  = 0;
+  this->adaptSize  = 0;
+  this->adaptCount = 0;
+
+  this->timeCount  = 0;
+  this->timeStamp  = 0;
+  this->errorCount = 0;
+  this->retryCount = 0;
+  this->dataCount  = 0;
+
+  this->code       = CodeNone;
+  this->stage      = StageNone;
+  this->rxDiscard  = 0;
+  this->rxStamp    = 0;
+  this->rxAbort    = CodeNone;
+  this->rxAccepted = 0;
+  this->rxSkip     = 0;
+
+  this->txBuffer      = txFrame[0];
+  this->txNextBuffer  = txFrame[1];
+  this->txNextLength  = 0;
+  this->txNextCode    = CodeNone;
+  this->txResent      = false;
+  this->txIgnored     = false;
+  this->txSendStamp   = 0;
+  this->txCarryOffset = 0;
+  this->txCarryLength = 0;
+  this->txCarryCode   = CodeNone;
+
+  this->windowCount = 0;
+  this->windowMask  = 0;
+  this->windowNak   = 0;
+  this->windowEnd   = false;
+
+  this->resumePending = false;
+
+  statsReset();
+}
+
+/**
+  * @brief  Set the fractional factor of the time the ymodem is called.
+  * @param  [in] timeDivide: The fractional factor of the time the ymodem is called.
+  * @return None.
+  */
+YMODEM_CORE_TEMPLATE
+void YMODEM_CORE::setTimeDivide(uint32_t timeDivide)
+{
+  this->timeDivide = timeDivide;
+}
+
+/**
+  * @brief  Get the fractional factor of the time the ymodem is called.
+  * @param  None.
+  * @return The fractional factor of the time the ymodem is called.
+  */
+YMODEM_CORE_TEMPLATE
+uint32_t YMODEM_CORE::getTimeDivide()
+{
+  return timeDivide;
+}
+
+/**
+  * @brief  Set the maximum time when calling the ymodem.
+  * @param  [in] timeMax: The maximum time when calling the ymodem.
+  * @return None.
+  */
+YMODEM_CORE_TEMPLATE
+void YMODEM_CORE::setTimeMax(uint32_t timeMax)
+{
+  this->timeMax = timeMax;
+}
+
+/**
+  * @brief  Get the maximum time when calling the ymodem.
+  * @param  None.
+  * @return The maximum time when calling the ymodem.
+  */
+YMODEM_CORE_TEMPLATE
+uint32_t YMODEM_CORE::getTimeMax()
+{
+  return timeMax;
+}
+
+/**
+  * @brief  Set the maximum error count when calling the ymodem.
+  * @param  [in] errorMax: The maximum error count when calling the ymodem.
+  * @return None.
+  */
+YMODEM_CORE_TEMPLATE
+void YMODEM_CORE::setErrorMax(uint32_t errorMax)
+{
+  this->errorMax = errorMax;
+}
+
+/**
+  * @brief  Get the maximum error count when calling the ymodem.
+  * @param  None.
+  * @return The maximum error count when calling the ymodem.
+  */
+YMODEM_CORE_TEMPLATE
+uint32_t YMODEM_CORE::getErrorMax()
+{
+  return errorMax;
+}
+
+/**
+  * @brief  Set the time unit in milliseconds.
+  * @param  [in] timeUnit: The time unit in milliseconds.
+  * @return None.
+  */
+YMODEM_CORE_TEMPLATE
+void YMODEM_CORE::setTimeUnit(uint32_t timeUnit)
+{
+  this->timeUnit = timeUnit;
+}
+
+/**
+  * @brief  Get the time unit in milliseconds.
+  * @param  None.
+  * @return The time unit in milliseconds.
+  */
+YMODEM_CORE_TEMPLATE
+uint32_t YMODEM_CORE::getTimeUnit()
+{
+  return timeUnit;
+}
+
+/**
+  * @brief  Set the engine used to calculate CRC16 checksum.
+  * @param  [in] crcEngine: The engine used to calculate CRC16 checksum.
+  * @return None.
+  */
+YMODEM_CORE_TEMPLATE
+void YMODEM_CORE::setCrcEngine(Crc16Engine crcEngine)
+{
+  this->crcEngine = crc16Supported(crcEngine) == true ? crcEngine : Crc16EngineAuto;
+}
+
+/**
+  * @brief  Get the engine used to calculate CRC16 checksum.
+  * @param  None.
+  * @return The engine used to calculate CRC16 checksum.
+  */
+YMODEM_CORE_TEMPLATE
+Crc16Engine YMODEM_CORE::getCrcEngine()
+{
+  return crcEngine;
+}
+
+/**
+  * @brief  Set the protocol options requested by the ymodem.
+  * @param  [in] options: The protocol options, a combination of @Option.
+  * @note   @OptionStreaming makes the receiver request YMODEM-g with 'G' instead of 'C',
+  *         the transmitter always honours a YMODEM-g request.
+  *         @OptionWindow makes the receiver request a windowed session with "X<options>C",
+  *         the transmitter confirms it in the last byte of the header packet, otherwise the
+  *         session falls back to plain YMODEM. In a windowed session up to @YMODEM_WINDOW_SIZE
+  *         packets are in flight, every ACK and NAK carries a packet number and only the
+  *         packets reported damaged are retransmitted.
+  *         @OptionExtended is negotiated the same way and lets the transmitter send packets of
+  *         @getExtendedSize bytes with 'ETX' and a CRC32, it is dropped in a windowed session.
+  *         @OptionResume is negotiated the same way, the transmitter only confirms it when it
+  *         is set on the transmitter too. The receiver asks for the resume offset of every file
+  *         with @StatusResume and sends it with "X<tag><offset><crc>", the transmitter seeks with
+  *         @StatusResume and confirms the offset in the header packet before any data is sent.
+  *         The offset is 8 bytes big-endian in the callback buffer.
+  *         @OptionCompress and @OptionDelta are negotiated like @OptionResume. The ymodem itself
+  *         does not touch the data, it tells both callbacks through @getSessionOptions that the
+  *         data stream is compressed or a delta against a base file.
+  *         Options are only negotiated in a batch session, the options the core is not built
+  *         for are dropped: all of them without @Batch, @OptionExtended up to a 1K block size.
+  * @return None.
+  */
+YMODEM_CORE_TEMPLATE
+void YMODEM_CORE::setOptions(uint32_t options)
+{
+  this->options = options & SupportedOptions;
+}
+
+/**
+  * @brief  Get the protocol options requested by the ymodem.
+  * @param  None.
+  * @return The protocol options.
+  */
+YMODEM_CORE_TEMPLATE
+uint32_t YMODEM_CORE::getOptions()
+{
+  return options;
+}
+
+/**
+  * @brief  Get the protocol options in effect for the current session.
+  * @param  None.
+  * @return The protocol options negotiated with the peer.
+  */
+YMODEM_CORE_TEMPLATE
+uint32_t YMODEM_CORE::getSessionOptions()
+{
+  return session;
+}
+
+/**
+  * @brief  Set the data size of the extended packets sent by the transmitter.
+  * @param  [in] extendedSize: The data size, 4096, 8192 or 32768.
+  * @note   A 32K packet takes about 3 seconds at 115200 baud, the retransmission interval
+  *         must be longer than the packet time.
+  *         The size is limited to the block size of the core.
+  * @return None.
+  */
+YMODEM_CORE_TEMPLATE
+void YMODEM_CORE::setExtendedSize(uint32_t extendedSize)
+{
+  if(extendedSize >= YMODEM_PACKET_EXT_SIZE)
+  {
+    this->extendedSize = YMODEM_PACKET_EXT_SIZE;
+  }
+  else if(extendedSize >= 8192)
+  {
+    this->extendedSize = 8192;
+  }
+  else
+  {
+    this->extendedSize = 4096;
+  }
+
+  if(this->extendedSize > BlockSize)
+  {
+    this->extendedSize = BlockSize;
+  }
+}
+
+/**
+  * @brief  Get the data size of the extended packets sent by the transmitter.
+  * @param  None.
+  * @return The data size of the extended packets.
+  */
+YMODEM_CORE_TEMPLATE
+uint32_t YMODEM_CORE::getExtendedSize()
+{
+  return extendedSize;
+}
+
+/**
+  * @brief  Set whether the transmitter adapts the packet size to the error rate.
+  * @param  [in] adaptive: Whether the packet size is adaptive.
+  * @note   The transmitter estimates the byte error rate of the line from the packets
+  *         acknowledged, NAKed or timed out, and every @YMODEM_ADAPT_PERIOD packets picks the
+  *         data size, 128, 1024 or the extended size of the session, that gives the best
+  *         expected goodput. On a clean line the largest size is taken after the first
+  *         2 * @YMODEM_ADAPT_WEIGHT packets.
+  *         The callback is offered the chosen size in @len and must not send more.
+  *         A streaming session is not adapted since any error ends it.
+  * @return None.
+  */
+YMODEM_CORE_TEMPLATE
+void YMODEM_CORE::setAdaptive(bool adaptive)
+{
+  this->adaptive = adaptive;
+}
+
+/**
+  * @brief  Get whether the transmitter adapts the packet size to the error rate.
+  * @param  None.
+  * @return Whether the packet size is adaptive.
+  */
+YMODEM_CORE_TEMPLATE
+bool YMODEM_CORE::getAdaptive()
+{
+  return adaptive;
+}
+
+/**
+  * @brief  Get the time until the next deadline of the current stage.
+  * @param  None.
+  * @note   The ymodem does not need to be called before the deadline unless data is received.
+  * @return The time until the next deadline in milliseconds, 0 if the ymodem should be called now.
+  */
+YMODEM_CORE_TEMPLATE
+uint32_t YMODEM_CORE::getTimeToDeadline()
+{
+  if(stage == StageNone)
+  {
+    return 0;
+  }
+
+  uint32_t elapsed  = tick() - timeStamp;
+  uint32_t deadline = (timeCount + 1) * (timeDivide + 1) * timeUnit;
+  uint32_t remain   = elapsed < deadline ? deadline - elapsed : 0;
+
+  uint32_t idle = tick() - rxStamp;
+
+  if(rxDiscard > 0)
+  {
+    remain = (idle < timeUnit) ? ((timeUnit - idle) < remain ? (timeUnit - idle) : remain) : 0;
+  }
+  else if((remain == 0) && (receiveBusy() == true))
+  {
+    remain = timeUnit - idle;
+  }
+
+  return remain;
+}
+
+/**
+  * @brief  Get the number of retries of the session.
+  * @param  None.
+  * @note   Every timeout, NAK or invalid packet that leads to a retransmission or a
+  *         NAK response counts as one retry. The count is reset when a session starts.
+  * @return The number of retries.
+  */
+YMODEM_CORE_TEMPLATE
+uint32_t YMODEM_CORE::getRetryCount()
+{
+  return retryCount;
+}
+
+/**
+  * @brief  Get the statistics of the current or last transfer.
+  * @param  None.
+  * @note   The statistics are reset when a session starts and stop counting time when it
+  *         ends, so they can be read in the callback of the final status or any time after.
+  *         An ACK round trip is timed from the first transmission of a data packet, packets
+  *         sent again are not timed since their ACK may answer either copy.
+  *         A streaming session has no ACKs to time.
+  * @return The statistics.
+  */
+YMODEM_CORE_TEMPLATE
+YmodemBase::Stats YMODEM_CORE::getTransferStats()
+{
+  Stats    result = stats;
+  uint64_t stop   = (statsStop != UINT64_MAX) ? statsStop : microTick();
+
+  result.retries        = retryCount;
+  result.elapsed        = stop - statsStart;
+  result.bytesPerSecond = (result.elapsed > 0) ? (result.bytes * 1000000 / result.elapsed) : 0;
+
+  if(stats.rttCount > 0)
+  {
+    uint32_t target = stats.rttCount - stats.rttCount / 100;
+    uint32_t count  = 0;
+
+    for(uint32_t i = 0; i < YMODEM_RTT_BUCKETS; i++)
+    {
+      count += rttHistogram[i];
+
+      if(count >= target)
+      {
+        result.rttP99 = rttBucketLimit(i) < stats.rttMax ? rttBucketLimit(i) : stats.rttMax;
+
+        break;
+      }
+    }
+
+    result.rttAverage = (uint32_t)(rttSum / stats.rttCount);
+  }
+
+  return result;
+}
+
+/**
+  * @brief  Ymodem receive.
+  * @param  None.
+  * @return None.
+  */
+YMODEM_CORE_TEMPLATE
+void YMODEM_CORE::receive()
+{
+  switch(stage)
+  {
+    case StageNone:
+    {
+      receiveStageNone();
+
+      break;
+    }
+
+    case StageEstablishing:
+    {
+      receiveStageEstablishing();
+
+      break;
+    }
+
+    case StageEstablished:
+    {
+      if(sessionHas(OptionWindow) == true)
+      {
+        receiveStageWindow();
+      }
+      else
+      {
+        receiveStageEstablished();
+      }
+
+      break;
+    }
+
+    case StageTransmitting:
+    {
+      if(sessionHas(OptionWindow) == true)
+      {
+        receiveStageWindow();
+      }
+      else
+      {
+        receiveStageTransmitting();
+      }
+
+      break;
+    }
+
+    case StageFinishing:
+    {
+      receiveStageFinishing();
+
+      break;
+    }
+
+    default:
+    {
+      receiveStageFinished();
+    }
+  }
+}
+
+/**
+  * @brief  Ymodem transmit.
+  * @param  None.
+  * @return None.
+  */
+YMODEM_CORE_TEMPLATE
+void YMODEM_CORE::transmit()
+{
+  switch(stage)
+  {
+    case StageNone:
+    {
+      transmitStageNone();
+
+      break;
+    }
+
+    case StageEstablishing:
+    {
+      transmitStageEstablishing();
+
+      break;
+    }
+
+    case StageEstablished:
+    {
+      transmitStageEstablished();
+
+      break;
+    }
+
+    case StageTransmitting:
+    {
+      if(sessionHas(OptionWindow) == true)
+      {
+        transmitStageWindow();
+      }
+      else
+      {
+        transmitStageTransmitting();
+      }
+
+      break;
+    }
+
+    case StageFinishing:
+    {
+      transmitStageFinishing();
+
+      break;
+    }
+
+    default:
+    {
+      transmitStageFinished();
+    }
+  }
+}
+
+/**
+  * @brief  Ymodem abort.
+  * @param  None.
+  * @return None.
+  */
+YMODEM_CORE_TEMPLATE
+void YMODEM_CORE::abort()
+{
+  timeCount  = 0;
+  timeStamp  = tick();
+  errorCount = 0;
+  dataCount  = 0;
+  code       = CodeNone;
+  stage      = StageNone;
+
+  if(statsStop == UINT64_MAX)
+  {
+    statsStop = microTick();
+  }
+
+  for(txLength = 0; txLength < YMODEM_CODE_CAN_NUMBER; txLength++)
+  {
+    txBuffer[txLength] = CodeCan;
+  }
+
+  send(txBuffer, txLength);
+}
+
+/**
+  * @brief  Check whether an option is in effect for the current session.
+  * @param  [in] option: The option.
+  * @note   The options the core is not built for are never in effect, so the compiler
+  *         drops the code that handles them.
+  * @return Whether the option is in effect.
+  */
+YMODEM_CORE_TEMPLATE
+bool YMODEM_CORE::sessionHas(uint32_t option)
+{
+  return (session & SupportedOptions & option) != 0;
+}
+
+/**
+  * @brief  Receives a packet of data.
+  * @param  None.
+  * @return Packet type.
+  */
+YMODEM_CORE_TEMPLATE
+YmodemBase::Code YMODEM_CORE::receivePacket()
+{
+  if(code == CodeNone)
+  {
+    if(read(&(rxBuffer[0]), 1) > 0)
+    {
+      if((rxBuffer[0] == CodeSoh) || ((PacketSize == YMODEM_PACKET_1K_SIZE) && (rxBuffer[0] == CodeStx)) ||
+         ((sessionHas(OptionExtended) == true) && (rxBuffer[0] == CodeEtx)))
+      {
+        code      = (Code)(rxBuffer[0]);
+        rxLength  = 1;
+        rxCrc     = 0;
+        rxValid   = false;
+        rxStamp   = tick();
+        rxAbort   = CodeNone;
+      }
+      else if(((Batch == true) && (rxBuffer[0] == CodeX)) ||
+              ((sessionHas(OptionWindow) == true) && ((rxBuffer[0] == CodeAck) || (rxBuffer[0] == CodeNak))))
+      {
+        code     = (Code)(rxBuffer[0]);
+        rxLength = 1;
+      }
+      else if(rxDiscard > 0)
+      {
+        /* Not a code but the rest of a damaged packet, which is answered once it has passed. */
+        rxDiscard = rxDiscard - 1;
+        rxStamp   = tick();
+
+        return (rxDiscard > 0) ? CodeNone : receiveDamaged();
+      }
+      else if(rxBuffer[0] == CodeEtx)
+      {
+        /* Not a packet outside an extended session, the receive buffer still holds the last packet. */
+        return CodeNone;
+      }
+      else if(((rxBuffer[0] == CodeCan) || (rxBuffer[0] == CodeA1) || (rxBuffer[0] == CodeA2)) &&
+              (rxBuffer[0] != rxAbort))
+      {
+        /* A single abort code may be noise, only the same code twice in a row aborts. */
+        rxAbort = (Code)(rxBuffer[0]);
+
+        return CodeNone;
+      }
+      else
+      {
+        rxAbort = CodeNone;
+
+        if((rxBuffer[0] == CodeNak) && (stage != StageFinishing))
+        {
+          stats.naks++;
+        }
+
+        return (Code)(rxBuffer[0]);
+      }
+    }
+    else if((rxDiscard > 0) && ((tick() - rxStamp) >= timeUnit))
+    {
+      /* The line has gone idle, the damaged packet was shorter than assumed. */
+      return receiveDamaged();
+    }
+    else
+    {
+      return CodeNone;
+    }
+  }
+
+  if(((code == CodeSoh) || (code == CodeStx) || (code == CodeEtx)) && (rxLength < YMODEM_PACKET_HEADER))
+  {
+    uint32_t offset = rxLength;
+
+    rxLength += read(&(rxBuffer[rxLength]), YMODEM_PACKET_HEADER - rxLength);
+
+    if(rxLength > offset)
+    {
+      rxStamp = tick();
+    }
+
+    if(rxLength < YMODEM_PACKET_HEADER)
+    {
+      return CodeNone;
+    }
+    else if(rxBuffer[2] != (uint8_t)(0xFF - rxBuffer[1]))
+    {
+      return receiveResync();
+    }
+  }
+
+  if((code == CodeSoh) || (code == CodeStx) || (code == CodeEtx))
+  {
+    uint32_t size     = packetSize(code);
+    uint32_t overhead = (code == CodeEtx) ? YMODEM_PACKET_EXT_OVERHEAD : PacketOverhead;
+    uint32_t offset   = rxLength;
+
+    rxLength += read(&(rxBuffer[rxLength]), size + overhead - rxLength);
+
+    if(rxLength > offset)
+    {
+      rxStamp = tick();
+    }
+
+    receivePacketCrc(offset, size);
+
+    if(rxLength < (size + overhead))
+    {
+      return CodeNone;
+    }
+    else
+    {
+      Code packet = code;
+
+      if(code == CodeEtx)
+      {
+        rxValid = rxCrc == (((uint32_t)(rxBuffer[size + overhead - 4]) << 24) |
+                            ((uint32_t)(rxBuffer[size + overhead - 3]) << 16) |
+                            ((uint32_t)(rxBuffer[size + overhead - 2]) << 8)  |
+                            ((uint32_t)(rxBuffer[size + overhead - 1]) << 0));
+      }
+      else
+      {
+        rxValid = rxCrc == Checksum::get(&(rxBuffer[size + overhead - Checksum::Size]));
+      }
+
+      stats.packetsReceived++;
+
+      if(rxValid != true)
+      {
+        stats.crcErrors++;
+      }
+
+      code      = CodeNone;
+      rxDiscard = 0;
+
+      return packet;
+    }
+  }
+  else if((code == CodeX) || (code == CodeAck) || (code == CodeNak))
+  {
+    if(rxLength < 2)
+    {
+      rxLength += read(&(rxBuffer[1]), 1);
+    }
+
+    uint32_t size = ((code == CodeX) && (rxLength >= 2) && (rxBuffer[1] == YMODEM_RESUME_TAG)) ? YMODEM_RESUME_FRAME : 2;
+
+    if(rxLength < size)
+    {
+      rxLength += read(&(rxBuffer[rxLength]), size - rxLength);
+    }
+
+    if(rxLength < size)
+    {
+      return CodeNone;
+    }
+    else
+    {
+      Code packet = code;
+
+      if(size == YMODEM_RESUME_FRAME)
+      {
+        rxValid = crc16(&(rxBuffer[2]), YMODEM_RESUME_SIZE) ==
+                  (uint16_t)(((uint16_t)(rxBuffer[size - 2]) << 8) | ((uint16_t)(rxBuffer[size - 1]) << 0));
+      }
+      else if((code == CodeNak) && (stage != StageFinishing))
+      {
+        stats.naks++;
+      }
+
+      code = CodeNone;
+
+      return packet;
+    }
+  }
+  else
+  {
+    code = CodeNone;
+
+    return CodeNone;
+  }
+}
+
+/**
+  * @brief  Check whether a packet is still arriving.
+  * @param  None.
+  * @note   A receive timeout is held back while the bytes of a packet keep arriving, so that
+  *         the NAK does not cut off the retransmission it is waiting for.
+  * @return Whether a packet is still arriving.
+  */
+YMODEM_CORE_TEMPLATE
+bool YMODEM_CORE::receiveBusy()
+{
+  return ((code == CodeSoh) || (code == CodeStx) || (code == CodeEtx)) && ((tick() - rxStamp) < timeUnit);
+}
+
+/**
+  * @brief  Drop a packet whose header is damaged and look for the next start code.
+  * @param  None.
+  * @note   A start code lost on the line makes the receiver find one in the data that
+  *         follows. Reading a whole packet from there would end in the middle of the
+  *         retransmission and find the same false start again, every time, so a start
+  *         code is only accepted when the packet number and its complement match.
+  *         Without another start code in the header the rest of the packet is discarded,
+  *         the data in it must not be taken for EOT or CAN, nor may a false start code
+  *         in it end the discard early.
+  * @return CodeNone.
+  */
+YMODEM_CORE_TEMPLATE
+YmodemBase::Code YMODEM_CORE::receiveResync()
+{
+  uint32_t i = 1;
+
+  while((i < rxLength) && (rxBuffer[i] != CodeSoh) &&
+        ((rxBuffer[i] != CodeStx) || (PacketSize != YMODEM_PACKET_1K_SIZE)) &&
+        ((rxBuffer[i] != CodeEtx) || (sessionHas(OptionExtended) != true)))
+  {
+    i++;
+  }
+
+  if(i < rxLength)
+  {
+    memmove(rxBuffer, &(rxBuffer[i]), rxLength - i);
+
+    code     = (Code)(rxBuffer[0]);
+    rxLength = rxLength - i;
+  }
+  else if(rxDiscard > 0)
+  {
+    rxDiscard = (rxDiscard > rxLength) ? (rxDiscard - rxLength) : 1;
+    rxStamp   = tick();
+    code      = CodeNone;
+    rxLength  = 0;
+  }
+  else
+  {
+    rxDiscard = packetSize(code) + ((code == CodeEtx) ? YMODEM_PACKET_EXT_OVERHEAD : PacketOverhead) - rxLength;
+    rxStamp   = tick();
+    code      = CodeNone;
+    rxLength  = 0;
+  }
+
+  return CodeNone;
+}
+
+/**
+  * @brief  Discard a packet whose start code was lost.
+  * @param  None.
+  * @note   Its length is unknown, so up to the longest packet of the session is discarded
+  *         and the discard also ends when the line goes idle for a time unit.
+  * @return None.
+  */
+YMODEM_CORE_TEMPLATE
+void YMODEM_CORE::receiveLost()
+{
+  if(sessionHas(OptionExtended) == true)
+  {
+    rxDiscard = sessionSize + YMODEM_PACKET_EXT_OVERHEAD - 1;
+  }
+  else
+  {
+    rxDiscard = PacketSize + PacketOverhead - 1;
+  }
+
+  rxStamp = tick();
+}
+
+/**
+  * @brief  End the discard of a damaged packet.
+  * @param  None.
+  * @note   The packet is reported as received with an error, so the stage answers it
+  *         as soon as it has passed instead of on timeout.
+  * @return CodeSoh.
+  */
+YMODEM_CORE_TEMPLATE
+YmodemBase::Code YMODEM_CORE::receiveDamaged()
+{
+  rxDiscard = 0;
+  rxValid   = false;
+
+  stats.packetsReceived++;
+  stats.crcErrors++;
+
+  return CodeSoh;
+}
+
+/**
+  * @brief  Pass the data of an accepted packet to the callback.
+  * @param  [in] size: The data size of the packet.
+  * @note   Data the transmitter has already sent in a longer copy of the previous
+  *         packet, see @receiveDuplicate, is skipped.
+  * @return The code of the callback, or CodeAck when all the data was skipped.
+  */
+YMODEM_CORE_TEMPLATE
+YmodemBase::Code YMODEM_CORE::receiveData(uint32_t size)
+{
+  uint32_t skip       = (rxSkip < size) ? rxSkip : size;
+  uint32_t dataLength = size - skip;
+
+  rxSkip     = rxSkip - skip;
+  rxAccepted = size;
+
+  if(dataLength == 0)
+  {
+    return CodeAck;
+  }
+
+  return notify(StatusTransmit, &(rxBuffer[YMODEM_PACKET_HEADER + skip]), &dataLength);
+}
+
+/**
+  * @brief  Note a duplicate of the previous packet.
+  * @param  [in] size: The data size of the duplicate.
+  * @note   A transmitter that missed the ACK may split the packet and send the rest of
+  *         its data in the packets that follow, so the data already taken beyond the
+  *         size of the duplicate is skipped when it comes again.
+  * @return None.
+  */
+YMODEM_CORE_TEMPLATE
+void YMODEM_CORE::receiveDuplicate(uint32_t size)
+{
+  if(size < rxAccepted)
+  {
+    rxSkip     = rxSkip + rxAccepted - size;
+    rxAccepted = size;
+  }
+}
+
+/**
+  * @brief  Update the checksum of the packet being received.
+  * @param  [in] offset: The length of the packet received before the last read.
+  * @param  [in] size:   The data size of the packet.
+  * @note   Only the data newly stored in the receive buffer is calculated,
+  *         so the packet is checked as soon as its last byte arrives.
+  *         Extended packets are checked with CRC32, the others with the checksum of the core.
+  * @return None.
+  */
+YMODEM_CORE_TEMPLATE
+void YMODEM_CORE::receivePacketCrc(uint32_t offset, uint32_t size)
+{
+  uint32_t first = offset   > YMODEM_PACKET_HEADER ? offset   : YMODEM_PACKET_HEADER;
+  uint32_t last  = rxLength < (YMODEM_PACKET_HEADER + size) ? rxLength : (YMODEM_PACKET_HEADER + size);
+
+  if((last > first) && (code == CodeEtx))
+  {
+    rxCrc = crc32Slice8(rxCrc, &(rxBuffer[first]), last - first);
+  }
+  else if(last > first)
+  {
+    rxCrc = Checksum::update(crcEngine, rxCrc, &(rxBuffer[first]), last - first);
+  }
+}
+
+/**
+  * @brief  Get the data size of a packet.
+  * @param  [in] code: The start code of the packet.
+  * @return The data size of the packet.
+  */
+YMODEM_CORE_TEMPLATE
+uint32_t YMODEM_CORE::packetSize(Code code)
+{
+  switch(code)
+  {
+    case CodeSoh:
+    {
+      return YMODEM_PACKET_SIZE;
+    }
+
+    case CodeStx:
+    {
+      return YMODEM_PACKET_1K_SIZE;
+    }
+
+    default:
+    {
+      return sessionSize;
+    }
+  }
+}
+
+/**
+  * @brief  Frame a data packet around the data stored in the buffer.
+  * @param  [in] buff:   The packet buffer, the data starts at @YMODEM_PACKET_HEADER.
+  * @param  [in] number: The packet number.
+  * @param  [in] size:   The data size, 128, 1024 or the extended size of the session.
+  * @return The length of the packet.
+  */
+YMODEM_CORE_TEMPLATE
+uint32_t YMODEM_CORE::framePacket(uint8_t *buff, uint8_t number, uint32_t size)
+{
+  buff[1] = number;
+  buff[2] = 0xFF - number;
+
+  if(size > YMODEM_PACKET_1K_SIZE)
+  {
+    uint32_t crc = crc32Slice8(0, &(buff[YMODEM_PACKET_HEADER]), size);
+
+    buff[0]                                     = CodeEtx;
+    buff[size + YMODEM_PACKET_EXT_OVERHEAD - 4] = (uint8_t)(crc >> 24);
+    buff[size + YMODEM_PACKET_EXT_OVERHEAD - 3] = (uint8_t)(crc >> 16);
+    buff[size + YMODEM_PACKET_EXT_OVERHEAD - 2] = (uint8_t)(crc >> 8);
+    buff[size + YMODEM_PACKET_EXT_OVERHEAD - 1] = (uint8_t)(crc >> 0);
+
+    return size + YMODEM_PACKET_EXT_OVERHEAD;
+  }
+  else
+  {
+    uint32_t crc = Checksum::update(crcEngine, 0, &(buff[YMODEM_PACKET_HEADER]), size);
+
+    buff[0] = size > YMODEM_PACKET_SIZE ? CodeStx : CodeSoh;
+
+    Checksum::put(&(buff[size + YMODEM_PACKET_HEADER]), crc);
+
+    return size + PacketOverhead;
+  }
+}
+
+/**
+  * @brief  Build the request asking the transmitter to send packets.
+  * @param  [out] buff: The buffer to store the request.
+  * @note   Before the header packet is accepted the negotiable options are requested
+  *         with "X<options>", which a plain transmitter skips before the 'C'.
+  *         A core checked with the arithmetic checksum requests with NAK instead of 'C'.
+  * @return The length of the request.
+  */
+YMODEM_CORE_TEMPLATE
+uint32_t YMODEM_CORE::receiveRequest(uint8_t *buff)
+{
+  uint32_t length = 0;
+
+  if((stage == StageEstablishing) && (sessionHas(OptionStreaming) != true) &&
+     ((options & YMODEM_OPTION_NEGOTIATED) != 0))
+  {
+    buff[length++] = CodeX;
+    buff[length++] = YMODEM_OPTION_MARK | (options & YMODEM_OPTION_NEGOTIATED);
+  }
+
+  if(sessionHas(OptionStreaming) == true)
+  {
+    buff[length++] = CodeG;
+  }
+  else
+  {
+    buff[length++] = (Checksum::Size == YMODEM_PACKET_TRAILER) ? CodeC : CodeNak;
+  }
+
+  return length;
+}
+
+/**
+  * @brief  Build the response to a packet.
+  * @param  [out] buff:   The buffer to store the response.
+  * @param  [in]  code:   The response code, ACK or NAK.
+  * @param  [in]  number: The packet number the response refers to.
+  * @note   The packet number is only sent in a windowed session.
+  * @return The length of the response.
+  */
+YMODEM_CORE_TEMPLATE
+uint32_t YMODEM_CORE::receiveResponse(uint8_t *buff, Code code, uint8_t number)
+{
+  buff[0] = code;
+
+  if(sessionHas(OptionWindow) == true)
+  {
+    buff[1] = number;
+
+    return 2;
+  }
+  else
+  {
+    return 1;
+  }
+}
+
+/**
+  * @brief  Build the request asking the transmitter to resume a file.
+  * @param  [out] buff: The buffer to store the request.
+  * @note   The resume offset is sent as "X<tag><offset><crc>" with a CRC16 of the offset.
+  * @return The length of the request.
+  */
+YMODEM_CORE_TEMPLATE
+uint32_t YMODEM_CORE::receiveResume(uint8_t *buff)
+{
+  uint16_t crc = crc16(resume, YMODEM_RESUME_SIZE);
+
+  buff[0] = CodeX;
+  buff[1] = YMODEM_RESUME_TAG;
+
+  memcpy(&(buff[2]), resume, YMODEM_RESUME_SIZE);
+
+  buff[YMODEM_RESUME_FRAME - 2] = (uint8_t)(crc >> 8);
+  buff[YMODEM_RESUME_FRAME - 1] = (uint8_t)(crc >> 0);
+
+  return YMODEM_RESUME_FRAME;
+}
+
+/**
+  * @brief  Accept the header packet of a file.
+  * @param  None.
+  * @note   In a resumable session the file is only accepted once the transmitter has
+  *         confirmed the resume offset in the header packet.
+  * @return None.
+  */
+YMODEM_CORE_TEMPLATE
+void YMODEM_CORE::receiveHeader()
+{
+  uint8_t *header     = &(rxBuffer[YMODEM_PACKET_HEADER]);
+  uint32_t dataLength = YMODEM_PACKET_SIZE;
+
+  if(resumePending == true)
+  {
+    if(((header[YMODEM_PACKET_SIZE - 1] & (YMODEM_OPTION_MARK | OptionResume)) == (YMODEM_OPTION_MARK | OptionResume)) &&
+       (memcmp(&(header[YMODEM_RESUME_POSITION]), resume, YMODEM_RESUME_SIZE) == 0))
+    {
+      timeCount      = 0;
+      timeStamp      = tick();
+      errorCount     = 0;
+      dataCount      = 0;
+      code           = CodeNone;
+      stage          = StageEstablished;
+      windowMask     = 0;
+      windowNak      = 0;
+      resumePending  = false;
+      txLength       = receiveResponse(txBuffer, CodeAck, 0x00);
+      txLength      += receiveRequest(&(txBuffer[txLength]));
+      send(txBuffer, txLength);
+    }
+    else
+    {
+      errorCount++;
+      retryCount++;
+
+      if(errorCount > errorMax)
+      {
+        timeCount  = 0;
+        timeStamp  = tick();
+        errorCount = 0;
+        dataCount  = 0;
+        code       = CodeNone;
+        stage      = StageNone;
+
+        for(txLength = 0; txLength < YMODEM_CODE_CAN_NUMBER; txLength++)
+        {
+          txBuffer[txLength] = CodeCan;
+        }
+
+        send(txBuffer, txLength);
+        notify(StatusError, NULL, NULL);
+      }
+      else
+      {
+        txLength = receiveResume(txBuffer);
+        send(txBuffer, txLength);
+      }
+    }
+  }
+  else if(notify(StatusEstablish, header, &dataLength) == CodeAck)
+  {
+    dataLength = YMODEM_RESUME_SIZE;
+    rxAccepted = 0;
+    rxSkip     = 0;
+
+    memset(resume, 0, YMODEM_RESUME_SIZE);
+
+    if((sessionHas(OptionResume) == true) && (notify(StatusResume, resume, &dataLength) == CodeAck))
+    {
+      timeCount     = 0;
+      timeStamp     = tick();
+      errorCount    = 0;
+      dataCount     = 0;
+      code          = CodeNone;
+      stage         = StageEstablishing;
+      resumePending = true;
+      txLength      = receiveResume(txBuffer);
+      send(txBuffer, txLength);
+    }
+    else
+    {
+      timeCount   = 0;
+      timeStamp   = tick();
+      errorCount  = 0;
+      dataCount   = 0;
+      code        = CodeNone;
+      stage       = StageEstablished;
+      windowMask  = 0;
+      windowNak   = 0;
+      txLength    = receiveResponse(txBuffer, CodeAck, 0x00);
+      txLength   += receiveRequest(&(txBuffer[txLength]));
+      send(txBuffer, txLength);
+    }
+  }
+  else
+  {
+    timeCount  = 0;
+    timeStamp  = tick();
+    errorCount = 0;
+    dataCount  = 0;
+    code       = CodeNone;
+    stage      = StageNone;
+
+    for(txLength = 0; txLength < YMODEM_CODE_CAN_NUMBER; txLength++)
+    {
+      txBuffer[txLength] = CodeCan;
+    }
+
+    send(txBuffer, txLength);
+  }
+}
+
+/**
+  * @brief  Receive none stage.
+  * @param  None.
+  * @note   XMODEM has no header packet, the request already asks for the first data packet.
+  * @return None.
+  */
+YMODEM_CORE_TEMPLATE
+void YMODEM_CORE::receiveStageNone()
+{
+  timeCount     = 0;
+  timeStamp     = tick();
+  errorCount    = 0;
+  retryCount    = 0;
+  dataCount     = 0;
+  code          = CodeNone;
+  stage         = (Batch == true) ? StageEstablishing : StageEstablished;
+  session       = options & OptionStreaming;
+  resumePending = false;
+  rxAccepted    = 0;
+  rxSkip        = 0;
+  statsReset();
+  txLength      = receiveRequest(txBuffer);
+  send(txBuffer, txLength);
+}
+
+/**
+  * @brief  Receive establishing stage.
+  * @param  None.
+  * @return None.
+  */
+YMODEM_CORE_TEMPLATE
+void YMODEM_CORE::receiveStageEstablishing()
+{
+  switch(receivePacket())
+  {
+    case CodeSoh:
+    {
+      if((rxBuffer[1] == 0x00) && (rxBuffer[2] == 0xFF) && (rxValid == true))
+      {
+        uint8_t  mark    = rxBuffer[YMODEM_PACKET_HEADER + YMODEM_PACKET_SIZE - 1];
+        uint32_t size    = rxBuffer[YMODEM_PACKET_HEADER + YMODEM_PACKET_SIZE - 2] * YMODEM_PACKET_1K_SIZE;
+        uint32_t offered = options & YMODEM_OPTION_NEGOTIATED;
+
+        /* Only a confirmation of the "X<options>" request is taken, anything else is file information. */
+        if((sessionHas(OptionStreaming) != true) && (offered != 0) && (resumePending == false) &&
+           ((mark & YMODEM_OPTION_MARK) != 0) && ((mark & ~(YMODEM_OPTION_MARK | offered)) == 0))
+        {
+          if((mark & OptionExtended) != 0)
+          {
+            if((size > YMODEM_PACKET_1K_SIZE) && (size <= BlockSize) && ((mark & OptionWindow) == 0))
+            {
+              session     = mark & YMODEM_OPTION_NEGOTIATED;
+              sessionSize = size;
+            }
+          }
+          else if(size == 0)
+          {
+            session     = mark & YMODEM_OPTION_NEGOTIATED;
+            sessionSize = YMODEM_PACKET_1K_SIZE;
+          }
+        }
+
+        receiveHeader();
+      }
+      else
+      {
+        errorCount++;
+        retryCount++;
+
+        if(errorCount > errorMax)
+        {
+          timeCount  = 0;
+          timeStamp  = tick();
+          errorCount = 0;
+          dataCount  = 0;
+          code       = CodeNone;
+          stage      = StageNone;
+
+          for(txLength = 0; txLength < YMODEM_CODE_CAN_NUMBER; txLength++)
+          {
+            txBuffer[txLength] = CodeCan;
+          }
+
+          send(txBuffer, txLength);
+          notify(StatusError, NULL, NULL);
+        }
+        else
+        {
+          txLength = receiveRequest(txBuffer);
+          send(txBuffer, txLength);
+        }
+      }
+
+      break;
+    }
+
+    case CodeA1:
+    case CodeA2:
+    case CodeCan:
+    {
+      timeCount  = 0;
+      timeStamp  = tick();
+      errorCount = 0;
+      dataCount  = 0;
+      code       = CodeNone;
+      stage      = StageNone;
+      notify(StatusAbort, NULL, NULL);
+
+      break;
+    }
+
+    default:
+    {
+      uint32_t count = timeUpdate();
+
+      if(count > timeMax)
+      {
+        timeCount  = 0;
+        timeStamp  = tick();
+        errorCount = 0;
+        dataCount  = 0;
+        code       = CodeNone;
+        stage      = StageNone;
+
+        for(txLength = 0; txLength < YMODEM_CODE_CAN_NUMBER; txLength++)
+        {
+          txBuffer[txLength] = CodeCan;
+        }
+
+        send(txBuffer, txLength);
+        notify(StatusTimeout, NULL, NULL);
+      }
+      else if((count > timeCount) && (receiveBusy() != true))
+      {
+        stats.timeouts++;
+
+        timeCount = count;
+        txLength  = receiveRequest(txBuffer);
+        send(txBuffer, txLength);
+      }
+    }
+  }
+}
+
+/**
+  * @brief  Receive established stage.
+  * @param  None.
+  * @note   Damaged packets and lost start codes are handled as in the transmitting stage.
+  * @return None.
+  */
+YMODEM_CORE_TEMPLATE
+void YMODEM_CORE::receiveStageEstablished()
+{
+  Code packet = receivePacket();
+
+  switch(packet)
+  {
+    case CodeSoh:
+    {
+      if((Batch == true) && (rxBuffer[1] == 0x00) && (rxBuffer[2] == 0xFF) && (rxValid == true))
+      {
+        errorCount++;
+        retryCount++;
+        stats.duplicates++;
+
+        if(errorCount > errorMax)
+        {
+          timeCount  = 0;
+          timeStamp  = tick();
+          errorCount = 0;
+          dataCount  = 0;
+          code       = CodeNone;
+          stage      = StageNone;
+
+          for(txLength = 0; txLength < YMODEM_CODE_CAN_NUMBER; txLength++)
+          {
+            txBuffer[txLength] = CodeCan;
+          }
+
+          send(txBuffer, txLength);
+          notify(StatusError, NULL, NULL);
+        }
+        else
+        {
+          txLength  = receiveResponse(txBuffer, CodeAck, 0x00);
+          txLength += receiveRequest(&(txBuffer[txLength]));
+          send(txBuffer, txLength);
+        }
+      }
+      else if((rxBuffer[1] == 0x01) && (rxBuffer[2] == 0xFE) && (rxValid == true))
+      {
+        if(receiveData(YMODEM_PACKET_SIZE) == CodeAck)
+        {
+          timeCount   = 0;
+          timeStamp   = tick();
+          errorCount  = 0;
+          dataCount   = 1;
+          code        = CodeNone;
+          stage       = StageTransmitting;
+
+          if(sessionHas(OptionStreaming) != true)
+          {
+            txBuffer[0] = CodeAck;
+            txLength    = 1;
+            send(txBuffer, txLength);
+          }
+        }
+        else
+        {
+          timeCount  = 0;
+          timeStamp  = tick();
+          errorCount = 0;
+          dataCount  = 0;
+          code       = CodeNone;
+          stage      = StageNone;
+
+          for(txLength = 0; txLength < YMODEM_CODE_CAN_NUMBER; txLength++)
+          {
+            txBuffer[txLength] = CodeCan;
+          }
+
+          send(txBuffer, txLength);
+        }
+      }
+      else
+      {
+        errorCount++;
+        retryCount++;
+
+        if((errorCount > errorMax) || (sessionHas(OptionStreaming) == true))
+        {
+          timeCount  = 0;
+          timeStamp  = tick();
+          errorCount = 0;
+          dataCount  = 0;
+          code       = CodeNone;
+          stage      = StageNone;
+
+          for(txLength = 0; txLength < YMODEM_CODE_CAN_NUMBER; txLength++)
+          {
+            txBuffer[txLength] = CodeCan;
+          }
+
+          send(txBuffer, txLength);
+          notify(StatusError, NULL, NULL);
+        }
+        else
+        {
+          timeCount   = 0;
+          timeStamp   = tick();
+          txBuffer[0] = CodeNak;
+          txLength    = 1;
+          send(txBuffer, txLength);
+        }
+      }
+
+      break;
+    }
+
+    case CodeStx:
+    case CodeEtx:
+    {
+      if((rxBuffer[1] == 0x01) && (rxBuffer[2] == 0xFE) && (rxValid == true))
+      {
+        if(receiveData(packetSize(packet)) == CodeAck)
+        {
+          timeCount   = 0;
+          timeStamp   = tick();
+          errorCount  = 0;
+          dataCount   = 1;
+          code        = CodeNone;
+          stage       = StageTransmitting;
+
+          if(sessionHas(OptionStreaming) != true)
+          {
+            txBuffer[0] = CodeAck;
+            txLength    = 1;
+            send(txBuffer, txLength);
+          }
+        }
+        else
+        {
+          timeCount  = 0;
+          timeStamp  = tick();
+          errorCount = 0;
+          dataCount  = 0;
+          code       = CodeNone;
+          stage      = StageNone;
+
+          for(txLength = 0; txLength < YMODEM_CODE_CAN_NUMBER; txLength++)
+          {
+            txBuffer[txLength] = CodeCan;
+          }
+
+          send(txBuffer, txLength);
+        }
+      }
+      else
+      {
+        errorCount++;
+        retryCount++;
+
+        if((errorCount > errorMax) || (sessionHas(OptionStreaming) == true))
+        {
+          timeCount  = 0;
+          timeStamp  = tick();
+          errorCount = 0;
+          dataCount  = 0;
+          code       = CodeNone;
+          stage      = StageNone;
+
+          for(txLength = 0; txLength < YMODEM_CODE_CAN_NUMBER; txLength++)
+          {
+            txBuffer[txLength] = CodeCan;
+          }
+
+          send(txBuffer, txLength);
+          notify(StatusError, NULL, NULL);
+        }
+        else
+        {
+          timeCount   = 0;
+          timeStamp   = tick();
+          txBuffer[0] = CodeNak;
+          txLength    = 1;
+          send(txBuffer, txLength);
+        }
+      }
+
+      break;
+    }
+
+    case CodeEot:
+    {
+      timeCount  = 0;
+      timeStamp  = tick();
+      errorCount = 0;
+      dataCount  = 0;
+      code       = CodeNone;
+
+      if(sessionHas(OptionStreaming) == true)
+      {
+        stage       = StageFinished;
+        txBuffer[0] = CodeAck;
+        txBuffer[1] = CodeG;
+        txLength    = 2;
+      }
+      else
+      {
+        stage       = StageFinishing;
+        txBuffer[0] = CodeNak;
+        txLength    = 1;
+      }
+
+      send(txBuffer, txLength);
+
+      break;
+    }
+
+    case CodeA1:
+    case CodeA2:
+    case CodeCan:
+    {
+      timeCount  = 0;
+      timeStamp  = tick();
+      errorCount = 0;
+      dataCount  = 0;
+      code       = CodeNone;
+      stage      = StageNone;
+      notify(StatusAbort, NULL, NULL);
+
+      break;
+    }
+
+    default:
+    {
+      uint32_t count = timeUpdate();
+
+      if(packet != CodeNone)
+      {
+        receiveLost();
+      }
+
+      if(count > timeMax)
+      {
+        timeCount  = 0;
+        timeStamp  = tick();
+        errorCount = 0;
+        dataCount  = 0;
+        code       = CodeNone;
+        stage      = StageNone;
+
+        for(txLength = 0; txLength < YMODEM_CODE_CAN_NUMBER; txLength++)
+        {
+          txBuffer[txLength] = CodeCan;
+        }
+
+        send(txBuffer, txLength);
+        notify((Batch == true) ? StatusError : StatusTimeout, NULL, NULL);
+      }
+      else if((count > timeCount) && (receiveBusy() != true))
+      {
+        stats.timeouts++;
+
+        timeCount = count;
+        code      = CodeNone;
+        rxDiscard = 0;
+
+        if(Batch != true)
+        {
+          /* Without a header packet the transmitter may not have started yet. */
+          txLength = receiveRequest(txBuffer);
+          send(txBuffer, txLength);
+        }
+        else if(sessionHas(OptionStreaming) != true)
+        {
+          txBuffer[0] = CodeNak;
+          txLength    = 1;
+          send(txBuffer, txLength);
+        }
+      }
+    }
+  }
+}
+
+/**
+  * @brief  Receive transmitting stage.
+  * @param  None.
+  * @note   A timeout drops the packet being received, its start code may have been
+  *         damaged into that of a longer packet which would never complete, and ends
+  *         a discard, whose damaged packet the NAK on timeout already answers. Every
+  *         response restarts the timeout, so a NAK on timeout never follows one that
+  *         the transmitter is still answering.
+  * @return None.
+  */
+YMODEM_CORE_TEMPLATE
+void YMODEM_CORE::receiveStageTransmitting()
+{
+  Code packet = receivePacket();
+
+  switch(packet)
+  {
+    case CodeSoh:
+    {
+      if((rxBuffer[1] == (uint8_t)(dataCount)) && (rxBuffer[2] == (uint8_t)(0xFF - dataCount)) &&
+         (rxValid == true))
+      {
+        errorCount++;
+        retryCount++;
+        stats.duplicates++;
+
+        receiveDuplicate(YMODEM_PACKET_SIZE);
+
+        if((errorCount > errorMax) || (sessionHas(OptionStreaming) == true))
+        {
+          timeCount  = 0;
+          timeStamp  = tick();
+          errorCount = 0;
+          dataCount  = 0;
+          code       = CodeNone;
+          stage      = StageNone;
+
+          for(txLength = 0; txLength < YMODEM_CODE_CAN_NUMBER; txLength++)
+          {
+            txBuffer[txLength] = CodeCan;
+          }
+
+          send(txBuffer, txLength);
+          notify(StatusError, NULL, NULL);
+        }
+        else
+        {
+          timeCount   = 0;
+          timeStamp   = tick();
+          txBuffer[0] = CodeAck;
+          txLength    = 1;
+          send(txBuffer, txLength);
+        }
+      }
+      else if((rxBuffer[1] == (uint8_t)(dataCount + 1)) && (rxBuffer[2] == (uint8_t)(0xFE - dataCount)) &&
+              (rxValid == true))
+      {
+        if(receiveData(YMODEM_PACKET_SIZE) == CodeAck)
+        {
+          timeCount   = 0;
+          timeStamp   = tick();
+          errorCount  = 0;
+          dataCount   = dataCount + 1;
+          code        = CodeNone;
+          stage       = StageTransmitting;
+
+          if(sessionHas(OptionStreaming) != true)
+          {
+            txBuffer[0] = CodeAck;
+            txLength    = 1;
+            send(txBuffer, txLength);
+          }
+        }
+        else
+        {
+          timeCount  = 0;
+          timeStamp  = tick();
+          errorCount = 0;
+          dataCount  = 0;
+          code       = CodeNone;
+          stage      = StageNone;
+
+          for(txLength = 0; txLength < YMODEM_CODE_CAN_NUMBER; txLength++)
+          {
+            txBuffer[txLength] = CodeCan;
+          }
+
+          send(txBuffer, txLength);
+        }
+      }
+      else if((rxValid == true) && (rxBuffer[2] == (uint8_t)(0xFF - rxBuffer[1])))
+      {
+        /* An intact packet out of sequence, the transmitter has skipped a packet that can not be resent. */
+        timeCount  = 0;
+        timeStamp  = tick();
+        errorCount = 0;
+        dataCount  = 0;
+        code       = CodeNone;
+        stage      = StageNone;
+
+        for(txLength = 0; txLength < YMODEM_CODE_CAN_NUMBER; txLength++)
+        {
+          txBuffer[txLength] = CodeCan;
+        }
+
+        send(txBuffer, txLength);
+        notify(StatusError, NULL, NULL);
+      }
+      else
+      {
+        errorCount++;
+        retryCount++;
+
+        if((errorCount > errorMax) || (sessionHas(OptionStreaming) == true))
+        {
+          timeCount  = 0;
+          timeStamp  = tick();
+          errorCount = 0;
+          dataCount  = 0;
+          code       = CodeNone;
+          stage      = StageNone;
+
+          for(txLength = 0; txLength < YMODEM_CODE_CAN_NUMBER; txLength++)
+          {
+            txBuffer[txLength] = CodeCan;
+          }
+
+          send(txBuffer, txLength);
+          notify(StatusError, NULL, NULL);
+        }
+        else
+        {
+          /* Restart the timeout, a NAK on timeout would otherwise cut into the resend. */
+          timeCount   = 0;
+          timeStamp   = tick();
+          txBuffer[0] = CodeNak;
+          txLength    = 1;
+          send(txBuffer, txLength);
+        }
+      }
+
+      break;
+    }
+
+    case CodeStx:
+    case CodeEtx:
+    {
+      if((rxBuffer[1] == (uint8_t)(dataCount)) && (rxBuffer[2] == (uint8_t)(0xFF - dataCount)) &&
+         (rxValid == true))
+      {
+        errorCount++;
+        retryCount++;
+        stats.duplicates++;
+
+        receiveDuplicate(packetSize(packet));
+
+        if((errorCount > errorMax) || (sessionHas(OptionStreaming) == true))
+        {
+          timeCount  = 0;
+          timeStamp  = tick();
+          errorCount = 0;
+          dataCount  = 0;
+          code       = CodeNone;
+          stage      = StageNone;
+
+          for(txLength = 0; txLength < YMODEM_CODE_CAN_NUMBER; txLength++)
+          {
+            txBuffer[txLength] = CodeCan;
+          }
+
+          send(txBuffer, txLength);
+          notify(StatusError, NULL, NULL);
+        }
+        else
+        {
+          timeCount   = 0;
+          timeStamp   = tick();
+          txBuffer[0] = CodeAck;
+          txLength    = 1;
+          send(txBuffer, txLength);
+        }
+      }
+      else if((rxBuffer[1] == (uint8_t)(dataCount + 1)) && (rxBuffer[2] == (uint8_t)(0xFE - dataCount)) &&
+              (rxValid == true))
+      {
+        if(receiveData(packetSize(packet)) == CodeAck)
+        {
+          timeCount   = 0;
+          timeStamp   = tick();
+          errorCount  = 0;
+          dataCount   = dataCount + 1;
+          code        = CodeNone;
+          stage       = StageTransmitting;
+
+          if(sessionHas(OptionStreaming) != true)
+          {
+            txBuffer[0] = CodeAck;
+            txLength    = 1;
+            send(txBuffer, txLength);
+          }
+        }
+        else
+        {
+          timeCount  = 0;
+          timeStamp  = tick();
+          errorCount = 0;
+          dataCount  = 0;
+          code       = CodeNone;
+          stage      = StageNone;
+
+          for(txLength = 0; txLength < YMODEM_CODE_CAN_NUMBER; txLength++)
+          {
+            txBuffer[txLength] = CodeCan;
+          }
+
+          send(txBuffer, txLength);
+        }
+      }
+      else if((rxValid == true) && (rxBuffer[2] == (uint8_t)(0xFF - rxBuffer[1])))
+      {
+        /* An intact packet out of sequence, the transmitter has skipped a packet that can not be resent. */
+        timeCount  = 0;
+        timeStamp  = tick();
+        errorCount = 0;
+        dataCount  = 0;
+        code       = CodeNone;
+        stage      = StageNone;
+
+        for(txLength = 0; txLength < YMODEM_CODE_CAN_NUMBER; txLength++)
+        {
+          txBuffer[txLength] = CodeCan;
+        }
+
+        send(txBuffer, txLength);
+        notify(StatusError, NULL, NULL);
+      }
+      else
+      {
+        errorCount++;
+        retryCount++;
+
+        if((errorCount > errorMax) || (sessionHas(OptionStreaming) == true))
+        {
+          timeCount  = 0;
+          timeStamp  = tick();
+          errorCount = 0;
+          dataCount  = 0;
+          code       = CodeNone;
+          stage      = StageNone;
+
+          for(txLength = 0; txLength < YMODEM_CODE_CAN_NUMBER; txLength++)
+          {
+            txBuffer[txLength] = CodeCan;
+          }
+
+          send(txBuffer, txLength);
+          notify(StatusError, NULL, NULL);
+        }
+        else
+        {
+          /* Restart the timeout, a NAK on timeout would otherwise cut into the resend. */
+          timeCount   = 0;
+          timeStamp   = tick();
+          txBuffer[0] = CodeNak;
+          txLength    = 1;
+          send(txBuffer, txLength);
+        }
+      }
+
+      break;
+    }
+
+    case CodeEot:
+    {
+      timeCount  = 0;
+      timeStamp  = tick();
+      errorCount = 0;
+      dataCount  = 0;
+      code       = CodeNone;
+
+      if(sessionHas(OptionStreaming) == true)
+      {
+        stage       = StageFinished;
+        txBuffer[0] = CodeAck;
+        txBuffer[1] = CodeG;
+        txLength    = 2;
+      }
+      else
+      {
+        stage       = StageFinishing;
+        txBuffer[0] = CodeNak;
+        txLength    = 1;
+      }
+
+      send(txBuffer, txLength);
+
+      break;
+    }
+
+    case CodeA1:
+    case CodeA2:
+    case CodeCan:
+    {
+      timeCount  = 0;
+      timeStamp  = tick();
+      errorCount = 0;
+      dataCount  = 0;
+      code       = CodeNone;
+      stage      = StageNone;
+      notify(StatusAbort, NULL, NULL);
+
+      break;
+    }
+
+    default:
+    {
+      uint32_t count = timeUpdate();
+
+      if(packet != CodeNone)
+      {
+        /* Not a code but a packet whose start code was lost. */
+        receiveLost();
+      }
+
+      if(count > timeMax)
+      {
+        timeCount  = 0;
+        timeStamp  = tick();
+        errorCount = 0;
+        dataCount  = 0;
+        code       = CodeNone;
+        stage      = StageNone;
+
+        for(txLength = 0; txLength < YMODEM_CODE_CAN_NUMBER; txLength++)
+        {
+          txBuffer[txLength] = CodeCan;
+        }
+
+        send(txBuffer, txLength);
+        notify(StatusError, NULL, NULL);
+      }
+      else if((count > timeCount) && (receiveBusy() != true))
+      {
+        stats.timeouts++;
+
+        timeCount = count;
+        code      = CodeNone;
+        rxDiscard = 0;
+
+        if(sessionHas(OptionStreaming) != true)
+        {
+          txBuffer[0] = CodeNak;
+          txLength    = 1;
+          send(txBuffer, txLength);
+        }
+      }
+    }
+  }
+}
+
+/**
+  * @brief  Receive finishing stage.
+  * @param  None.
+  * @return None.
+  */
+YMODEM_CORE_TEMPLATE
+void YMODEM_CORE::receiveStageFinishing()
+{
+  switch(receivePacket())
+  {
+    case CodeEot:
+    {
+      if(Batch != true)
+      {
+        /* XMODEM ends with the file, there is no header packet to request. */
+        timeCount   = 0;
+        timeStamp   = tick();
+        errorCount  = 0;
+        dataCount   = 0;
+        code        = CodeNone;
+        stage       = StageNone;
+        txLength    = receiveResponse(txBuffer, CodeAck, 0x00);
+        send(txBuffer, txLength);
+        notify(StatusFinish, NULL, NULL);
+      }
+      else
+      {
+        timeCount   = 0;
+        timeStamp   = tick();
+        errorCount  = 0;
+        dataCount   = 0;
+        code        = CodeNone;
+        stage       = StageFinished;
+        txLength    = receiveResponse(txBuffer, CodeAck, 0x00);
+        txLength   += receiveRequest(&(txBuffer[txLength]));
+        send(txBuffer, txLength);
+      }
+
+      break;
+    }
+
+    case CodeA1:
+    case CodeA2:
+    case CodeCan:
+    {
+      timeCount  = 0;
+      timeStamp  = tick();
+      errorCount = 0;
+      dataCount  = 0;
+      code       = CodeNone;
+      stage      = StageNone;
+      notify(StatusAbort, NULL, NULL);
+
+      break;
+    }
+
+    default:
+    {
+      uint32_t count = timeUpdate();
+
+      if(count > timeMax)
+      {
+        timeCount  = 0;
+        timeStamp  = tick();
+        errorCount = 0;
+        dataCount  = 0;
+        code       = CodeNone;
+        stage      = StageNone;
+
+        for(txLength = 0; txLength < YMODEM_CODE_CAN_NUMBER; txLength++)
+        {
+          txBuffer[txLength] = CodeCan;
+        }
+
+        send(txBuffer, txLength);
+        notify(StatusError, NULL, NULL);
+      }
+      else if((count > timeCount) && (receiveBusy() != true))
+      {
+        stats.timeouts++;
+
+        timeCount = count;
+        txLength  = receiveResponse(txBuffer, CodeNak, 0x00);
+        send(txBuffer, txLength);
+      }
+    }
+  }
+}
+
+/**
+  * @brief  Receive finished stage.
+  * @param  None.
+  * @return None.
+  */
+YMODEM_CORE_TEMPLATE
+void YMODEM_CORE::receiveStageFinished()
+{
+  switch(receivePacket())
+  {
+    case CodeSoh:
+    {
+      if((rxBuffer[1] == 0x00) && (rxBuffer[2] == 0xFF) && (rxValid == true) &&
+         (rxBuffer[YMODEM_PACKET_HEADER] != 0x00))
+      {
+        receiveHeader();
+      }
+      else if((rxBuffer[1] == 0x00) && (rxBuffer[2] == 0xFF) && (rxValid == true))
+      {
+        timeCount   = 0;
+        timeStamp   = tick();
+        errorCount  = 0;
+        dataCount   = 0;
+        code        = CodeNone;
+        stage       = StageNone;
+        txLength    = receiveResponse(txBuffer, CodeAck, 0x00);
+        send(txBuffer, txLength);
+        notify(StatusFinish, NULL, NULL);
+      }
+      else
+      {
+        errorCount++;
+        retryCount++;
+
+        if(errorCount > errorMax)
+        {
+          timeCount  = 0;
+          timeStamp  = tick();
+          errorCount = 0;
+          dataCount  = 0;
+          code       = CodeNone;
+          stage      = StageNone;
+
+          for(txLength = 0; txLength < YMODEM_CODE_CAN_NUMBER; txLength++)
+          {
+            txBuffer[txLength] = CodeCan;
+          }
+
+          send(txBuffer, txLength);
+          notify(StatusError, NULL, NULL);
+        }
+        else
+        {
+          txLength = receiveResponse(txBuffer, CodeNak, 0x00);
+          send(txBuffer, txLength);
+        }
+      }
+
+      break;
+    }
+
+    case CodeEot:
+    {
+      errorCount++;
+      retryCount++;
+
+      if(errorCount > errorMax)
+      {
+        timeCount  = 0;
+        timeStamp  = tick();
+        errorCount = 0;
+        dataCount  = 0;
+        code       = CodeNone;
+        stage      = StageNone;
+
+        for(txLength = 0; txLength < YMODEM_CODE_CAN_NUMBER; txLength++)
+        {
+          txBuffer[txLength] = CodeCan;
+        }
+
+        send(txBuffer, txLength);
+        notify(StatusError, NULL, NULL);
+      }
+      else
+      {
+        txLength  = receiveResponse(txBuffer, CodeAck, 0x00);
+        txLength += receiveRequest(&(txBuffer[txLength]));
+        send(txBuffer, txLength);
+      }
+
+      break;
+    }
+
+    case CodeA1:
+    case CodeA2:
+    case CodeCan:
+    {
+      timeCount  = 0;
+      timeStamp  = tick();
+      errorCount = 0;
+      dataCount  = 0;
+      code       = CodeNone;
+      stage      = StageNone;
+      notify(StatusAbort, NULL, NULL);
+
+      break;
+    }
+
+    default:
+    {
+      uint32_t count = timeUpdate();
+
+      if(count > timeMax)
+      {
+        timeCount  = 0;
+        timeStamp  = tick();
+        errorCount = 0;
+        dataCount  = 0;
+        code       = CodeNone;
+        stage      = StageNone;
+
+        for(txLength = 0; txLength < YMODEM_CODE_CAN_NUMBER; txLength++)
+        {
+          txBuffer[txLength] = CodeCan;
+        }
+
+        send(txBuffer, txLength);
+        notify(StatusError, NULL, NULL);
+      }
+      else if((count > timeCount) && (receiveBusy() != true))
+      {
+        stats.timeouts++;
+
+        timeCount = count;
+        txLength  = receiveResponse(txBuffer, CodeNak, 0x00);
+        send(txBuffer, txLength);
+      }
+    }
+  }
+}
+
+/**
+  * @brief  Receive stage of a windowed session.
+  * @param  None.
+  * @note   Packets ahead of the next expected one are kept in the receive window and
+  *         delivered in order once the missing packets arrive, the missing packets are
+  *         requested by NAK with their number. Damaged packets and lost start codes are
+  *         handled as in the transmitting stage.
+  * @return None.
+  */
+YMODEM_CORE_TEMPLATE
+void YMODEM_CORE::receiveStageWindow()
+{
+  Code packet = receivePacket();
+
+  switch(packet)
+  {
+    case CodeSoh:
+    case CodeStx:
+    {
+      uint8_t number = rxBuffer[1];
+      uint8_t offset = number - (uint8_t)(dataCount + 1);
+
+      if((stage == StageEstablished) && (number == 0x00) && (rxBuffer[2] == 0xFF) && (rxValid == true))
+      {
+        errorCount++;
+        retryCount++;
+        stats.duplicates++;
+
+        if(errorCount > errorMax)
+        {
+          timeCount  = 0;
+          timeStamp  = tick();
+          errorCount = 0;
+          dataCount  = 0;
+          code       = CodeNone;
+          stage      = StageNone;
+
+          for(txLength = 0; txLength < YMODEM_CODE_CAN_NUMBER; txLength++)
+          {
+            txBuffer[txLength] = CodeCan;
+          }
+
+          send(txBuffer, txLength);
+          notify(StatusError, NULL, NULL);
+        }
+        else
+        {
+          txLength  = receiveResponse(txBuffer, CodeAck, 0x00);
+          txLength += receiveRequest(&(txBuffer[txLength]));
+          send(txBuffer, txLength);
+        }
+      }
+      else if((rxBuffer[2] == (uint8_t)(0xFF - number)) && (rxValid == true) && (offset < YMODEM_WINDOW_SIZE))
+      {
+        txLength = 0;
+
+        if(offset == 0)
+        {
+          uint8_t *buff = rxBuffer;
+
+          while(buff != NULL)
+          {
+            uint32_t dataLength = (buff[0] == CodeSoh) ? YMODEM_PACKET_SIZE : YMODEM_PACKET_1K_SIZE;
+
+            if(notify(StatusTransmit, &(buff[YMODEM_PACKET_HEADER]), &dataLength) != CodeAck)
+            {
+              timeCount  = 0;
+              timeStamp  = tick();
+              errorCount = 0;
+              dataCount  = 0;
+              code       = CodeNone;
+              stage      = StageNone;
+
+              for(txLength = 0; txLength < YMODEM_CODE_CAN_NUMBER; txLength++)
+              {
+                txBuffer[txLength] = CodeCan;
+              }
+
+              send(txBuffer, txLength);
+
+              return;
+            }
+
+            dataCount  = dataCount + 1;
+            windowMask = windowMask & ~YMODEM_WINDOW_BIT(dataCount);
+            windowNak  = windowNak  & ~YMODEM_WINDOW_BIT(dataCount);
+            buff       = ((windowMask & YMODEM_WINDOW_BIT(dataCount + 1)) != 0) ?
+                         rxWindow[YMODEM_WINDOW_SLOT(dataCount + 1)] : NULL;
+          }
+
+          timeCount  = 0;
+          timeStamp  = tick();
+          errorCount = 0;
+          code       = CodeNone;
+          stage      = StageTransmitting;
+        }
+        else
+        {
+          if((windowMask & YMODEM_WINDOW_BIT(number)) == 0)
+          {
+            memcpy(rxWindow[YMODEM_WINDOW_SLOT(number)], rxBuffer, rxLength);
+
+            windowMask = windowMask | YMODEM_WINDOW_BIT(number);
+          }
+          else
+          {
+            stats.duplicates++;
+          }
+
+          for(uint8_t i = 0; i < offset; i++)
+          {
+            uint8_t missing = dataCount + 1 + i;
+
+            if(((windowMask | windowNak) & YMODEM_WINDOW_BIT(missing)) == 0)
+            {
+              windowNak  = windowNak | YMODEM_WINDOW_BIT(missing);
+              txLength  += receiveResponse(&(txBuffer[txLength]), CodeNak, missing);
+            }
+          }
+        }
+
+        txLength += receiveResponse(&(txBuffer[txLength]), CodeAck, number);
+        send(txBuffer, txLength);
+      }
+      else if((rxBuffer[2] == (uint8_t)(0xFF - number)) && (rxValid == true) &&
+              ((uint8_t)(dataCount - number) < YMODEM_WINDOW_SIZE))
+      {
+        errorCount++;
+        retryCount++;
+        stats.duplicates++;
+
+        if(errorCount > errorMax)
+        {
+          timeCount  = 0;
+          timeStamp  = tick();
+          errorCount = 0;
+          dataCount  = 0;
+          code       = CodeNone;
+          stage      = StageNone;
+
+          for(txLength = 0; txLength < YMODEM_CODE_CAN_NUMBER; txLength++)
+          {
+            txBuffer[txLength] = CodeCan;
+          }
+
+          send(txBuffer, txLength);
+          notify(StatusError, NULL, NULL);
+        }
+        else
+        {
+          txLength = receiveResponse(txBuffer, CodeAck, number);
+          send(txBuffer, txLength);
+        }
+      }
+      else
+      {
+        errorCount++;
+        retryCount++;
+
+        if(errorCount > errorMax)
+        {
+          timeCount  = 0;
+          timeStamp  = tick();
+          errorCount = 0;
+          dataCount  = 0;
+          code       = CodeNone;
+          stage      = StageNone;
+
+          for(txLength = 0; txLength < YMODEM_CODE_CAN_NUMBER; txLength++)
+          {
+            txBuffer[txLength] = CodeCan;
+          }
+
+          send(txBuffer, txLength);
+          notify(StatusError, NULL, NULL);
+        }
+        else if((rxBuffer[2] == (uint8_t)(0xFF - number)) && (offset < YMODEM_WINDOW_SIZE) &&
+                ((windowMask & YMODEM_WINDOW_BIT(number)) == 0))
+        {
+          windowNak = windowNak | YMODEM_WINDOW_BIT(number);
+          txLength  = receiveResponse(txBuffer, CodeNak, number);
+          send(txBuffer, txLength);
+        }
+      }
+
+      break;
+    }
+
+    case CodeEot:
+    {
+      timeCount  = 0;
+      timeStamp  = tick();
+      errorCount = 0;
+      dataCount  = 0;
+      code       = CodeNone;
+      stage      = StageFinishing;
+      txLength   = receiveResponse(txBuffer, CodeNak, 0x00);
+      send(txBuffer, txLength);
+
+      break;
+    }
+
+    case CodeA1:
+    case CodeA2:
+    case CodeCan:
+    {
+      timeCount  = 0;
+      timeStamp  = tick();
+      errorCount = 0;
+      dataCount  = 0;
+      code       = CodeNone;
+      stage      = StageNone;
+      notify(StatusAbort, NULL, NULL);
+
+      break;
+    }
+
+    default:
+    {
+      uint32_t count = timeUpdate();
+
+      if(packet != CodeNone)
+      {
+        receiveLost();
+      }
+
+      if(count > timeMax)
+      {
+        timeCount  = 0;
+        timeStamp  = tick();
+        errorCount = 0;
+        dataCount  = 0;
+        code       = CodeNone;
+        stage      = StageNone;
+
+        for(txLength = 0; txLength < YMODEM_CODE_CAN_NUMBER; txLength++)
+        {
+          txBuffer[txLength] = CodeCan;
+        }
+
+        send(txBuffer, txLength);
+        notify(StatusError, NULL, NULL);
+      }
+      else if((count > timeCount) && (receiveBusy() != true))
+      {
+        stats.timeouts++;
+
+        timeCount = count;
+        code      = CodeNone;
+        rxDiscard = 0;
+
+        if(stage == StageEstablished)
+        {
+          txLength = receiveRequest(txBuffer);
+        }
+        else
+        {
+          windowNak = YMODEM_WINDOW_BIT(dataCount + 1);
+          txLength  = receiveResponse(txBuffer, CodeNak, dataCount + 1);
+        }
+
+        send(txBuffer, txLength);
+      }
+    }
+  }
+}
+
+/**
+  * @brief  Transmit none stage.
+  * @param  None.
+  * @return None.
+  */
+YMODEM_CORE_TEMPLATE
+void YMODEM_CORE::transmitStageNone()
+{
+  timeCount     = 0;
+  timeStamp     = tick();
+  errorCount    = 0;
+  retryCount    = 0;
+  dataCount     = 0;
+  code          = CodeNone;
+  stage         = StageEstablishing;
+  session       = OptionNone;
+  txResent      = false;
+  txIgnored     = false;
+  txCarryOffset = 0;
+  txCarryLength = 0;
+  txCarryCode   = CodeNone;
+  adaptRate     = 0;
+  adaptSize     = 0;
+  adaptCount    = 0;
+  statsReset();
+}
+
+/**
+  * @brief  Transmit establishing stage.
+  * @param  None.
+  * @note   XMODEM has no header packet, the request starts the first data packet.
+  * @return None.
+  */
+YMODEM_CORE_TEMPLATE
+void YMODEM_CORE::transmitStageEstablishing()
+{
+  Code packet = receivePacket();
+
+  /* Only the request for the checksum the core is built for starts a session. */
+  if(((packet == CodeC) && (Checksum::Size != YMODEM_PACKET_TRAILER)) ||
+     ((packet == CodeNak) && (Checksum::Size == YMODEM_PACKET_TRAILER)) ||
+     ((packet == CodeG) && ((SupportedOptions & OptionStreaming) == 0)))
+  {
+    packet = CodeNone;
+  }
+
+  switch(packet)
+  {
+    case CodeX:
+    {
+      session = rxBuffer[1] & YMODEM_OPTION_NEGOTIATED & SupportedOptions;
+
+      if(sessionHas(OptionWindow) == true)
+      {
+        session = session & ~OptionExtended;
+      }
+
+      /* Resume, compression and delta are only confirmed when the transmitter supports them too. */
+      session = session & ~((OptionResume | OptionCompress | OptionDelta) & ~options);
+
+      break;
+    }
+
+    case CodeC:
+    case CodeG:
+    case CodeNak:
+    {
+      if(Batch != true)
+      {
+        /* A NAK request repeated on timeout may cross the first packet, it must not resend it. */
+        transmitFirst();
+
+        if(stage == StageEstablished)
+        {
+          transmitStart();
+        }
+
+        txResent  = packet == CodeNak;
+        txIgnored = false;
+
+        break;
+      }
+
+      session = (packet == CodeG) ? (uint32_t)(OptionStreaming) : (session & YMODEM_OPTION_NEGOTIATED);
+
+      memset(&(txBuffer[YMODEM_PACKET_HEADER]), 0, YMODEM_PACKET_SIZE);
+
+      txLength = YMODEM_PACKET_SIZE;
+
+      if(notify(StatusEstablish, &(txBuffer[YMODEM_PACKET_HEADER]), &(txLength)) == CodeAck)
+      {
+        /* The confirmation needs the last two bytes of the header, file information there is kept. */
+        if(((session & YMODEM_OPTION_NEGOTIATED) != 0) &&
+           (txBuffer[YMODEM_PACKET_HEADER + YMODEM_PACKET_SIZE - 2] == 0x00) &&
+           (txBuffer[YMODEM_PACKET_HEADER + YMODEM_PACKET_SIZE - 1] == 0x00))
+        {
+          sessionSize = (sessionHas(OptionExtended) == true) ? extendedSize : YMODEM_PACKET_1K_SIZE;
+
+          txBuffer[YMODEM_PACKET_HEADER + YMODEM_PACKET_SIZE - 2] = (sessionHas(OptionExtended) == true) ?
+                                                                    (uint8_t)(sessionSize / YMODEM_PACKET_1K_SIZE) : 0x00;
+          txBuffer[YMODEM_PACKET_HEADER + YMODEM_PACKET_SIZE - 1] = YMODEM_OPTION_MARK | session;
+        }
+        else
+        {
+          session = session & OptionStreaming;
+        }
+
+        uint16_t crc = crc16(&(txBuffer[YMODEM_PACKET_HEADER]), txLength);
+
+        timeCount                                       = 0;
+        timeStamp                                       = tick();
+        errorCount                                      = 0;
+        dataCount                                       = 0;
+        code                                            = CodeNone;
+        stage                                           = StageEstablished;
+        txBuffer[0]                                     = CodeSoh;
+        txBuffer[1]                                     = 0x00;
+        txBuffer[2]                                     = 0xFF;
+        txBuffer[txLength + YMODEM_PACKET_OVERHEAD - 2] = (uint8_t)(crc >> 8);
+        txBuffer[txLength + YMODEM_PACKET_OVERHEAD - 1] = (uint8_t)(crc >> 0);
+        txLength                                        = txLength + YMODEM_PACKET_OVERHEAD;
+        send(txBuffer, txLength);
+      }
+      else
+      {
+        timeCount  = 0;
+        timeStamp  = tick();
+        errorCount = 0;
+        dataCount  = 0;
+        code       = CodeNone;
+        stage      = StageNone;
+
+        for(txLength = 0; txLength < YMODEM_CODE_CAN_NUMBER; txLength++)
+        {
+          txBuffer[txLength] = CodeCan;
+        }
+
+        send(txBuffer, txLength);
+      }
+
+      break;
+    }
+
+    case CodeA1:
+    case CodeA2:
+    case CodeCan:
+    {
+      timeCount  = 0;
+      timeStamp  = tick();
+      errorCount = 0;
+      dataCount  = 0;
+      code       = CodeNone;
+      stage      = StageNone;
+      notify(StatusAbort, NULL, NULL);
+
+      break;
+    }
+
+    default:
+    {
+      uint32_t count = timeUpdate();
+
+      if(count > timeMax)
+      {
+        timeCount  = 0;
+        timeStamp  = tick();
+        errorCount = 0;
+        dataCount  = 0;
+        code       = CodeNone;
+        stage      = StageNone;
+
+        for(txLength = 0; txLength < YMODEM_CODE_CAN_NUMBER; txLength++)
+        {
+          txBuffer[txLength] = CodeCan;
+        }
+
+        send(txBuffer, txLength);
+        notify(StatusTimeout, NULL, NULL);
+      }
+    }
+  }
+}
+
+/**
+  * @brief  Transmit established stage.
+  * @param  None.
+  * @return None.
+  */
+YMODEM_CORE_TEMPLATE
+void YMODEM_CORE::transmitStageEstablished()
+{
+  switch(receivePacket())
+  {
+    case CodeNak:
+    {
+      errorCount++;
+      retryCount++;
+
+      if(errorCount > errorMax)
+      {
+        timeCount  = 0;
+        timeStamp  = tick();
+        errorCount = 0;
+        dataCount  = 0;
+        code       = CodeNone;
+        stage      = StageNone;
+
+        for(txLength = 0; txLength < YMODEM_CODE_CAN_NUMBER; txLength++)
+        {
+          txBuffer[txLength] = CodeCan;
+        }
+
+        send(txBuffer, txLength);
+        notify(StatusError, NULL, NULL);
+      }
+      else
+      {
+        send(txBuffer, txLength);
+      }
+
+      break;
+    }
+
+    case CodeC:
+    case CodeG:
+    {
+      errorCount++;
+
+      /* After the header ACK the 'C' asks for the first data packet, only before it is a retry. */
+      if(dataCount == 0)
+      {
+        retryCount++;
+      }
+
+      if(errorCount > errorMax)
+      {
+        timeCount  = 0;
+        timeStamp  = tick();
+        errorCount = 0;
+        dataCount  = 0;
+        code       = CodeNone;
+        stage      = StageNone;
+
+        for(txLength = 0; txLength < YMODEM_CODE_CAN_NUMBER; txLength++)
+        {
+          txBuffer[txLength] = CodeCan;
+        }
+
+        send(txBuffer, txLength);
+        notify(StatusError, NULL, NULL);
+      }
+      else
+      {
+        transmitStart();
+      }
+
+      break;
+    }
+
+    case CodeX:
+    {
+      if((rxBuffer[1] == YMODEM_RESUME_TAG) && (rxValid == true) && (sessionHas(OptionResume) == true))
+      {
+        uint8_t *header     = &(txBuffer[YMODEM_PACKET_HEADER + YMODEM_RESUME_POSITION]);
+        uint32_t dataLength = YMODEM_RESUME_SIZE;
+        bool     free       = dataCount == 0;
+        uint8_t  confirm[YMODEM_RESUME_SIZE + 2];
+
+        memcpy(confirm, &(rxBuffer[2]), YMODEM_RESUME_SIZE);
+
+        confirm[YMODEM_RESUME_SIZE + 0] = (sessionHas(OptionExtended) == true) ? (uint8_t)(sessionSize / YMODEM_PACKET_1K_SIZE) : 0x00;
+        confirm[YMODEM_RESUME_SIZE + 1] = YMODEM_OPTION_MARK | session;
+
+        for(uint32_t i = 0; i < sizeof(confirm); i++)
+        {
+          if((header[i] != 0x00) && (header[i] != confirm[i]))
+          {
+            free = false;
+          }
+        }
+
+        if((free == true) && (notify(StatusResume, &(rxBuffer[2]), &dataLength) == CodeAck))
+        {
+          memcpy(header, confirm, sizeof(confirm));
+
+          timeCount  = 0;
+          timeStamp  = tick();
+          errorCount = 0;
+          code       = CodeNone;
+          txLength   = framePacket(txBuffer, 0x00, YMODEM_PACKET_SIZE);
+          send(txBuffer, txLength);
+        }
+        else
+        {
+          timeCount  = 0;
+          timeStamp  = tick();
+          errorCount = 0;
+          dataCount  = 0;
+          code       = CodeNone;
+          stage      = StageNone;
+
+          for(txLength = 0; txLength < YMODEM_CODE_CAN_NUMBER; txLength++)
+          {
+            txBuffer[txLength] = CodeCan;
+          }
+
+          send(txBuffer, txLength);
+          notify(StatusError, NULL, NULL);
+        }
+      }
+
+      break;
+    }
+
+    case CodeAck:
+    {
+      /* A repeated ACK of the header must not read the first packet again. */
+      if(dataCount == 0)
+      {
+        statsAcknowledge(txBuffer[1]);
+        transmitFirst();
+      }
+
+      break;
+    }
+
+    case CodeA1:
+    case CodeA2:
+    case CodeCan:
+    {
+      timeCount  = 0;
+      timeStamp  = tick();
+      errorCount = 0;
+      dataCount  = 0;
+      code       = CodeNone;
+      stage      = StageNone;
+      notify(StatusAbort, NULL, NULL);
+
+      break;
+    }
+
+    default:
+    {
+      uint32_t count = timeUpdate();
+
+      if(count > timeMax)
+      {
+        timeCount  = 0;
+        timeStamp  = tick();
+        errorCount = 0;
+        dataCount  = 0;
+        code       = CodeNone;
+        stage      = StageNone;
+
+        for(txLength = 0; txLength < YMODEM_CODE_CAN_NUMBER; txLength++)
+        {
+          txBuffer[txLength] = CodeCan;
+        }
+
+        send(txBuffer, txLength);
+        notify(StatusError, NULL, NULL);
+      }
+      else if(count > timeCount)
+      {
+        stats.timeouts++;
+
+        timeCount = count;
+        send(txBuffer, txLength);
+      }
+    }
+  }
+}
+
+/**
+  * @brief  Transmit transmitting stage.
+  * @param  None.
+  * @return None.
+  */
+YMODEM_CORE_TEMPLATE
+void YMODEM_CORE::transmitStageTransmitting()
+{
+  Code packet = receivePacket();
+
+  /* In streaming mode a packet is acknowledged as soon as it has been written. */
+  if((sessionHas(OptionStreaming) == true) && (packet == CodeNone))
+  {
+    packet = CodeAck;
+  }
+
+  switch(packet)
+  {
+    case CodeNak:
+    {
+      errorCount++;
+      retryCount++;
+
+      if((errorCount > errorMax) || (sessionHas(OptionStreaming) == true))
+      {
+        timeCount  = 0;
+        timeStamp  = tick();
+        errorCount = 0;
+        dataCount  = 0;
+        code       = CodeNone;
+        stage      = StageNone;
+
+        for(txLength = 0; txLength < YMODEM_CODE_CAN_NUMBER; txLength++)
+        {
+          txBuffer[txLength] = CodeCan;
+        }
+
+        send(txBuffer, txLength);
+        notify(StatusError, NULL, NULL);
+      }
+      else if(transmitCrossed() == true)
+      {
+        /* The NAK crossed the resend on timeout, a second copy would be acknowledged twice. */
+        txResent  = false;
+        txIgnored = true;
+      }
+      else
+      {
+        /* Restart the timeout, a resend on timeout right after this one would be acknowledged twice. */
+        txResent  = false;
+        timeCount = 0;
+        timeStamp = tick();
+        adaptUpdate(txLength, true);
+        transmitSplit();
+        send(txBuffer, txLength);
+      }
+
+      break;
+    }
+
+    case CodeAck:
+    {
+      txResent  = false;
+      txIgnored = false;
+
+      if(sessionHas(OptionStreaming) != true)
+      {
+        statsAcknowledge(txBuffer[1]);
+        adaptUpdate(txLength, false);
+      }
+
+      switch(txNextCode)
+      {
+        case CodeAck:
+        {
+          uint8_t *buff = txBuffer;
+
+          timeCount    = 0;
+          timeStamp    = tick();
+          errorCount   = 0;
+          dataCount    = dataCount + 1;
+          code         = CodeNone;
+          stage        = StageTransmitting;
+          txBuffer     = txNextBuffer;
+          txLength     = txNextLength;
+          txNextBuffer = buff;
+          send(txBuffer, txLength);
+          transmitPrebuild();
+
+          break;
+        }
+
+        case CodeEot:
+        {
+          timeCount   = 0;
+          timeStamp   = tick();
+          errorCount  = 0;
+          dataCount   = 0;
+          code        = CodeNone;
+          stage       = StageFinishing;
+          txBuffer[0] = CodeEot;
+          txLength    = 1;
+          send(txBuffer, txLength);
+
+          break;
+        }
+
+        default:
+        {
+          timeCount  = 0;
+          timeStamp  = tick();
+          errorCount = 0;
+          dataCount  = 0;
+          code       = CodeNone;
+          stage      = StageNone;
+
+          for(txLength = 0; txLength < YMODEM_CODE_CAN_NUMBER; txLength++)
+          {
+            txBuffer[txLength] = CodeCan;
+          }
+
+          send(txBuffer, txLength);
+        }
+      }
+
+      break;
+    }
+
+    case CodeA1:
+    case CodeA2:
+    case CodeCan:
+    {
+      timeCount  = 0;
+      timeStamp  = tick();
+      errorCount = 0;
+      dataCount  = 0;
+      code       = CodeNone;
+      stage      = StageNone;
+      notify(StatusAbort, NULL, NULL);
+
+      break;
+    }
+
+    default:
+    {
+      uint32_t count = timeUpdate();
+
+      if(count > timeMax)
+      {
+        timeCount  = 0;
+        timeStamp  = tick();
+        errorCount = 0;
+        dataCount  = 0;
+        code       = CodeNone;
+        stage      = StageNone;
+
+        for(txLength = 0; txLength < YMODEM_CODE_CAN_NUMBER; txLength++)
+        {
+          txBuffer[txLength] = CodeCan;
+        }
+
+        send(txBuffer, txLength);
+        notify(StatusError, NULL, NULL);
+      }
+      else if(count > timeCount)
+      {
+        stats.timeouts++;
+
+        timeCount = count;
+        txResent  = true;
+        adaptUpdate(txLength, true);
+        send(txBuffer, txLength);
+      }
+    }
+  }
+}
+
+/**
+  * @brief  Build the first data packet of a file.
+  * @param  None.
+  * @note   The packet is only sent by @transmitStart, once the receiver asks for it.
+  * @return None.
+  */
+YMODEM_CORE_TEMPLATE
+void YMODEM_CORE::transmitFirst()
+{
+  txLength = (sessionHas(OptionExtended) == true) ? sessionSize : (uint32_t)(PacketSize);
+
+  memset(&(txBuffer[YMODEM_PACKET_HEADER]), 0, txLength);
+
+  txLength = adaptPacketSize();
+
+  switch(notify(StatusTransmit, &(txBuffer[YMODEM_PACKET_HEADER]), &(txLength)))
+  {
+    case CodeAck:
+    {
+      timeCount  = 0;
+      timeStamp  = tick();
+      errorCount = 0;
+      dataCount  = 1;
+      code       = CodeNone;
+      stage      = StageEstablished;
+      txLength   = framePacket(txBuffer, 0x01, txLength);
+
+      break;
+    }
+
+    case CodeEot:
+    {
+      timeCount   = 0;
+      timeStamp   = tick();
+      errorCount  = 0;
+      dataCount   = 2;
+      code        = CodeNone;
+      stage       = StageEstablished;
+      txBuffer[0] = CodeEot;
+      txLength    = 1;
+
+      break;
+    }
+
+    default:
+    {
+      timeCount  = 0;
+      timeStamp  = tick();
+      errorCount = 0;
+      dataCount  = 0;
+      code       = CodeNone;
+      stage      = StageNone;
+
+      for(txLength = 0; txLength < YMODEM_CODE_CAN_NUMBER; txLength++)
+      {
+        txBuffer[txLength] = CodeCan;
+      }
+
+      send(txBuffer, txLength);
+    }
+  }
+}
+
+/**
+  * @brief  Send the first data packet of a file and start the transmitting stage.
+  * @param  None.
+  * @note   An empty file goes straight to the finishing stage with EOT.
+  * @return None.
+  */
+YMODEM_CORE_TEMPLATE
+void YMODEM_CORE::transmitStart()
+{
+  timeCount  = 0;
+  timeStamp  = tick();
+  errorCount = 0;
+  dataCount  = dataCount;
+  code       = CodeNone;
+  stage      = (Stage)(stage + dataCount);
+  send(txBuffer, txLength);
+
+  if((sessionHas(OptionWindow) == true) && (stage == StageTransmitting))
+  {
+    memcpy(txWindow[YMODEM_WINDOW_SLOT(dataCount)], txBuffer, txLength);
+
+    txWindowLength[YMODEM_WINDOW_SLOT(dataCount)] = txLength;
+    windowCount                                   = 1;
+    windowMask                                    = 0;
+    windowEnd                                     = false;
+
+    transmitWindowFill();
+  }
+  else if(stage == StageTransmitting)
+  {
+    transmitPrebuild();
+  }
+}
+
+/**
+  * @brief  Build the next packet while the current one is in flight.
+  * @param  None.
+  * @note   The next packet is framed in the spare transmit buffer, so an ACK only has to
+  *         swap the buffers and write, the current packet stays in @txBuffer for retransmission.
+  * @return None.
+  */
+YMODEM_CORE_TEMPLATE
+void YMODEM_CORE::transmitPrebuild()
+{
+  uint32_t length = (sessionHas(OptionExtended) == true) ? sessionSize : (uint32_t)(PacketSize);
+
+  memset(&(txNextBuffer[YMODEM_PACKET_HEADER]), 0, length);
+
+  length = adaptPacketSize();
+
+  txNextCode = transmitData(&(txNextBuffer[YMODEM_PACKET_HEADER]), &length);
+
+  if(txNextCode == CodeAck)
+  {
+    txNextLength = framePacket(txNextBuffer, dataCount + 1, length);
+  }
+}
+
+/**
+  * @brief  Transmit finishing stage.
+  * @param  None.
+  * @note   XMODEM has no header packet to follow, the ACK of EOT ends the session.
+  * @return None.
+  */
+YMODEM_CORE_TEMPLATE
+void YMODEM_CORE::transmitStageFinishing()
+{
+  Code packet = receivePacket();
+
+  if((Batch != true) && (packet == CodeAck))
+  {
+    timeCount  = 0;
+    timeStamp  = tick();
+    errorCount = 0;
+    dataCount  = 0;
+    code       = CodeNone;
+    stage      = StageNone;
+    notify(StatusFinish, NULL, NULL);
+
+    return;
+  }
+
+  if((Batch != true) && ((packet == CodeC) || (packet == CodeG)))
+  {
+    packet = CodeNone;
+  }
+
+  switch(packet)
+  {
+    case CodeNak:
+    {
+      timeCount   = 0;
+      timeStamp   = tick();
+      errorCount  = 0;
+      dataCount   = 0;
+      code        = CodeNone;
+      stage       = StageFinishing;
+      txBuffer[0] = CodeEot;
+      txLength    = 1;
+      send(txBuffer, txLength);
+
+      break;
+    }
+
+    case CodeC:
+    case CodeG:
+    {
+      memset(&(txBuffer[YMODEM_PACKET_HEADER]), 0, YMODEM_PACKET_SIZE);
+
+      txLength = YMODEM_PACKET_SIZE;
+
+      switch(notify(StatusEstablish, &(txBuffer[YMODEM_PACKET_HEADER]), &(txLength)))
+      {
+        case CodeAck:
+        {
+          timeCount  = 0;
+          timeStamp  = tick();
+          errorCount = 0;
+          dataCount  = 0;
+          code       = CodeNone;
+          stage      = StageEstablished;
+          txLength   = framePacket(txBuffer, 0x00, YMODEM_PACKET_SIZE);
+          send(txBuffer, txLength);
+
+          break;
+        }
+
+        case CodeEot:
+        {
+          memset(&(txBuffer[YMODEM_PACKET_HEADER]), 0, YMODEM_PACKET_SIZE);
+
+          timeCount  = 0;
+          timeStamp  = tick();
+          errorCount = 0;
+          dataCount  = 0;
+          code       = CodeNone;
+          stage      = StageFinished;
+          txLength   = framePacket(txBuffer, 0x00, YMODEM_PACKET_SIZE);
+          send(txBuffer, txLength);
+
+          break;
+        }
+
+        default:
+        {
+          timeCount  = 0;
+          timeStamp  = tick();
+          errorCount = 0;
+          dataCount  = 0;
+          code       = CodeNone;
+          stage      = StageNone;
+
+          for(txLength = 0; txLength < YMODEM_CODE_CAN_NUMBER; txLength++)
+          {
+            txBuffer[txLength] = CodeCan;
+          }
+
+          send(txBuffer, txLength);
+        }
+      }
+
+      break;
+    }
+
+    case CodeA1:
+    case CodeA2:
+    case CodeCan:
+    {
+      timeCount  = 0;
+      timeStamp  = tick();
+      errorCount = 0;
+      dataCount  = 0;
+      code       = CodeNone;
+      stage      = StageNone;
+      notify(StatusAbort, NULL, NULL);
+
+      break;
+    }
+
+    default:
+    {
+      uint32_t count = timeUpdate();
+
+      if(count > timeMax)
+      {
+        timeCount  = 0;
+        timeStamp  = tick();
+        errorCount = 0;
+        dataCount  = 0;
+        code       = CodeNone;
+        stage      = StageNone;
+
+        for(txLength = 0; txLength < YMODEM_CODE_CAN_NUMBER; txLength++)
+        {
+          txBuffer[txLength] = CodeCan;
+        }
+
+        send(txBuffer, txLength);
+        notify(StatusError, NULL, NULL);
+      }
+      else if(count > timeCount)
+      {
+        stats.timeouts++;
+
+        timeCount = count;
+        send(txBuffer, txLength);
+      }
+    }
+  }
+}
+
+/**
+  * @brief  Transmit finished stage.
+  * @param  None.
+  * @return None.
+  */
+YMODEM_CORE_TEMPLATE
+void YMODEM_CORE::transmitStageFinished()
+{
+  switch(receivePacket())
+  {
+    case CodeC:
+    case CodeG:
+    case CodeNak:
+    {
+      errorCount++;
+      retryCount++;
+
+      if(errorCount > errorMax)
+      {
+        timeCount  = 0;
+        timeStamp  = tick();
+        errorCount = 0;
+        dataCount  = 0;
+        code       = CodeNone;
+        stage      = StageNone;
+
+        for(txLength = 0; txLength < YMODEM_CODE_CAN_NUMBER; txLength++)
+        {
+          txBuffer[txLength] = CodeCan;
+        }
+
+        send(txBuffer, txLength);
+        notify(StatusError, NULL, NULL);
+      }
+      else
+      {
+        send(txBuffer, txLength);
+      }
+
+      break;
+    }
+
+    case CodeAck:
+    {
+      statsAcknowledge(txBuffer[1]);
+
+      timeCount  = 0;
+      timeStamp  = tick();
+      errorCount = 0;
+      dataCount  = 0;
+      code       = CodeNone;
+      stage      = StageNone;
+      notify(StatusFinish, NULL, NULL);
+
+      break;
+    }
+
+    case CodeA1:
+    case CodeA2:
+    case CodeCan:
+    {
+      timeCount  = 0;
+      timeStamp  = tick();
+      errorCount = 0;
+      dataCount  = 0;
+      code       = CodeNone;
+      stage      = StageNone;
+      notify(StatusAbort, NULL, NULL);
+
+      break;
+    }
+
+    default:
+    {
+      uint32_t count = timeUpdate();
+
+      if(count > timeMax)
+      {
+        timeCount  = 0;
+        timeStamp  = tick();
+        errorCount = 0;
+        dataCount  = 0;
+        code       = CodeNone;
+        stage      = StageNone;
+
+        for(txLength = 0; txLength < YMODEM_CODE_CAN_NUMBER; txLength++)
+        {
+          txBuffer[txLength] = CodeCan;
+        }
+
+        send(txBuffer, txLength);
+        notify(StatusError, NULL, NULL);
+      }
+      else if(count > timeCount)
+      {
+        stats.timeouts++;
+
+        timeCount = count;
+        send(txBuffer, txLength);
+      }
+    }
+  }
+}
+
+/**
+  * @brief  Transmit stage of a windowed session.
+  * @param  None.
+  * @note   The window slides past every packet acknowledged in order, a NAK resends only
+  *         the packet it names and a timeout resends the oldest unacknowledged packet.
+  * @return None.
+  */
+YMODEM_CORE_TEMPLATE
+void YMODEM_CORE::transmitStageWindow()
+{
+  uint8_t base = dataCount + 1 - windowCount;
+
+  switch(receivePacket())
+  {
+    case CodeAck:
+    {
+      if(((uint8_t)(rxBuffer[1] - base) < windowCount) && ((windowMask & YMODEM_WINDOW_BIT(rxBuffer[1])) == 0))
+      {
+        windowMask = windowMask | YMODEM_WINDOW_BIT(rxBuffer[1]);
+
+        statsAcknowledge(rxBuffer[1]);
+        adaptUpdate(txWindowLength[YMODEM_WINDOW_SLOT(rxBuffer[1])], false);
+      }
+
+      while((windowCount > 0) && ((windowMask & YMODEM_WINDOW_BIT(base)) != 0))
+      {
+        timeCount   = 0;
+        timeStamp   = tick();
+        errorCount  = 0;
+        windowMask  = windowMask & ~YMODEM_WINDOW_BIT(base);
+        windowCount = windowCount - 1;
+        base        = base + 1;
+      }
+
+      transmitWindowFill();
+
+      break;
+    }
+
+    case CodeNak:
+    {
+      if(((uint8_t)(rxBuffer[1] - base) < windowCount) && ((windowMask & YMODEM_WINDOW_BIT(rxBuffer[1])) == 0))
+      {
+        errorCount++;
+        retryCount++;
+
+        if(errorCount > errorMax)
+        {
+          timeCount  = 0;
+          timeStamp  = tick();
+          errorCount = 0;
+          dataCount  = 0;
+          code       = CodeNone;
+          stage      = StageNone;
+
+          for(txLength = 0; txLength < YMODEM_CODE_CAN_NUMBER; txLength++)
+          {
+            txBuffer[txLength] = CodeCan;
+          }
+
+          send(txBuffer, txLength);
+          notify(StatusError, NULL, NULL);
+        }
+        else
+        {
+          adaptUpdate(txWindowLength[YMODEM_WINDOW_SLOT(rxBuffer[1])], true);
+          send(txWindow[YMODEM_WINDOW_SLOT(rxBuffer[1])], txWindowLength[YMODEM_WINDOW_SLOT(rxBuffer[1])]);
+        }
+      }
+
+      break;
+    }
+
+    case CodeA1:
+    case CodeA2:
+    case CodeCan:
+    {
+      timeCount  = 0;
+      timeStamp  = tick();
+      errorCount = 0;
+      dataCount  = 0;
+      code       = CodeNone;
+      stage      = StageNone;
+      notify(StatusAbort, NULL, NULL);
+
+      break;
+    }
+
+    default:
+    {
+      uint32_t count = timeUpdate();
+
+      if(count > timeMax)
+      {
+        timeCount  = 0;
+        timeStamp  = tick();
+        errorCount = 0;
+        dataCount  = 0;
+        code       = CodeNone;
+        stage      = StageNone;
+
+        for(txLength = 0; txLength < YMODEM_CODE_CAN_NUMBER; txLength++)
+        {
+          txBuffer[txLength] = CodeCan;
+        }
+
+        send(txBuffer, txLength);
+        notify(StatusError, NULL, NULL);
+      }
+      else if(count > timeCount)
+      {
+        stats.timeouts++;
+
+        timeCount = count;
+
+        if(windowCount > 0)
+        {
+          adaptUpdate(txWindowLength[YMODEM_WINDOW_SLOT(base)], true);
+          send(txWindow[YMODEM_WINDOW_SLOT(base)], txWindowLength[YMODEM_WINDOW_SLOT(base)]);
+        }
+      }
+    }
+  }
+}
+
+/**
+  * @brief  Fill the transmit window with new packets.
+  * @param  None.
+  * @note   Once the data is exhausted and every packet is acknowledged, EOT is sent.
+  * @return None.
+  */
+YMODEM_CORE_TEMPLATE
+void YMODEM_CORE::transmitWindowFill()
+{
+  while((stage == StageTransmitting) && (windowCount < YMODEM_WINDOW_SIZE) && (windowEnd == false))
+  {
+    uint8_t  number = dataCount + 1;
+    uint8_t *packet = txWindow[YMODEM_WINDOW_SLOT(number)];
+    uint32_t length = adaptPacketSize();
+
+    memset(&(packet[YMODEM_PACKET_HEADER]), 0, PacketSize);
+
+    switch(notify(StatusTransmit, &(packet[YMODEM_PACKET_HEADER]), &length))
+    {
+      case CodeAck:
+      {
+        dataCount                                  = number;
+        windowCount                                = windowCount + 1;
+        txWindowLength[YMODEM_WINDOW_SLOT(number)] = framePacket(packet, number, length);
+        send(packet, txWindowLength[YMODEM_WINDOW_SLOT(number)]);
+
+        break;
+      }
+
+      case CodeEot:
+      {
+        windowEnd = true;
+
+        break;
+      }
+
+      default:
+      {
+        timeCount  = 0;
+        timeStamp  = tick();
+        errorCount = 0;
+        dataCount  = 0;
+        code       = CodeNone;
+        stage      = StageNone;
+
+        for(txLength = 0; txLength < YMODEM_CODE_CAN_NUMBER; txLength++)
+        {
+          txBuffer[txLength] = CodeCan;
+        }
+
+        send(txBuffer, txLength);
+      }
+    }
+  }
+
+  if((stage == StageTransmitting) && (windowCount == 0) && (windowEnd == true))
+  {
+    timeCount   = 0;
+    timeStamp   = tick();
+    errorCount  = 0;
+    dataCount   = 0;
+    code        = CodeNone;
+    stage       = StageFinishing;
+    txBuffer[0] = CodeEot;
+    txLength    = 1;
+    send(txBuffer, txLength);
+  }
+}
+
+/**
+  * @brief  Check whether a NAK crossed the last resend on timeout.
+  * @param  None.
+  * @note   A NAK the receiver sent on its own timeout may arrive just after the resend and
+  *         must not be answered with another copy. A NAK for the resend itself can only come
+  *         back after the whole packet has reached the receiver, about one round trip later,
+  *         so only a NAK within @rttHalf of the resend is taken as crossed. At most one NAK
+  *         is ignored per packet, a damaged resend is always answered.
+  * @return Whether the NAK is to be ignored.
+  */
+YMODEM_CORE_TEMPLATE
+bool YMODEM_CORE::transmitCrossed()
+{
+  return (txResent == true) && (txIgnored != true) && ((microTick() - txSendStamp) < rttHalf());
+}
+
+/**
+  * @brief  Get half the average round trip of a packet.
+  * @param  None.
+  * @note   A time unit is taken before any round trip is measured.
+  * @return The time in microseconds.
+  */
+YMODEM_CORE_TEMPLATE
+uint64_t YMODEM_CORE::rttHalf()
+{
+  return (stats.rttCount > 0) ? (rttSum / stats.rttCount / 2) : ((uint64_t)(timeUnit) * 1000);
+}
+
+/**
+  * @brief  Split the packet being resent into smaller ones.
+  * @param  None.
+  * @note   A shrink of the adaptive size only applies to packets built after it, while a
+  *         NAKed packet is resent as it is, so a packet too long for the line would be
+  *         resent until @errorMax. Once the adaptive size is smaller, the packet keeps its
+  *         number with the first part of its data, and the rest of its data and the data of
+  *         the prebuilt packet are carried over to the packets that follow. The carried data
+  *         are whole packets of 128 bytes or more, so no padding lands inside the file.
+  *         The last packet of XMODEM is not split, it has no size to drop the padding with.
+  *         A NAK within @rttHalf of the send may answer an earlier copy and a resend on
+  *         timeout may follow a lost ACK, neither splits the packet. Should a split copy still
+  *         reach a receiver that has taken the whole packet, it skips the data it already has,
+  *         see @receiveDuplicate.
+  * @return None.
+  */
+YMODEM_CORE_TEMPLATE
+void YMODEM_CORE::transmitSplit()
+{
+  uint32_t size   = packetSize((Code)(txBuffer[0]));
+  uint32_t length = adaptPacketSize();
+
+  uint32_t next  = (txNextCode == CodeAck) ? packetSize((Code)(txNextBuffer[0])) : 0;
+  uint32_t carry = size - length + next;
+
+  if(((microTick() - txSendStamp) < rttHalf()) || (length >= size) || ((Batch != true) && (txNextCode != CodeAck)) ||
+     ((txCarryLength + carry) > sizeof(txCarry)))
+  {
+    return;
+  }
+
+  memmove(&(txCarry[carry]), &(txCarry[txCarryOffset]), txCarryLength);
+  memcpy(txCarry, &(txBuffer[YMODEM_PACKET_HEADER + length]), size - length);
+  memcpy(&(txCarry[size - length]), &(txNextBuffer[YMODEM_PACKET_HEADER]), next);
+
+  if(txNextCode != CodeAck)
+  {
+    txCarryCode = txNextCode;
+  }
+
+  txCarryOffset = 0;
+  txCarryLength = txCarryLength + carry;
+  txLength      = framePacket(txBuffer, txBuffer[1], length);
+
+  transmitPrebuild();
+}
+
+/**
+  * @brief  Get the data of the next packet.
+  * @param  [out]    buff: The buffer to store the data.
+  * @param  [in,out] len:  The data size offered, the size of the packet on return.
+  * @note   Data carried over from a split packet is sent before the callback is asked for
+  *         more, a carried size smaller than the offer is sent in 1K or 128 byte packets.
+  * @return The code of the callback, or CodeAck for carried data.
+  */
+YMODEM_CORE_TEMPLATE
+YmodemBase::Code YMODEM_CORE::transmitData(uint8_t *buff, uint32_t *len)
+{
+  if(txCarryLength > 0)
+  {
+    if(txCarryLength < *len)
+    {
+      *len = (txCarryLength >= YMODEM_PACKET_1K_SIZE) ? YMODEM_PACKET_1K_SIZE : YMODEM_PACKET_SIZE;
+    }
+
+    memcpy(buff, &(txCarry[txCarryOffset]), *len);
+
+    txCarryOffset = txCarryOffset + *len;
+    txCarryLength = txCarryLength - *len;
+
+    return CodeAck;
+  }
+  else if(txCarryCode != CodeNone)
+  {
+    Code result = txCarryCode;
+
+    txCarryCode = CodeNone;
+
+    return result;
+  }
+
+  return notify(StatusTransmit, buff, len);
+}
+
+/**
+  * @brief  Choose the data size of the next packet.
+  * @param  None.
+  * @note   The size only changes after @YMODEM_ADAPT_PERIOD packets have been sent at the
+  *         current one and the expected goodput of the new size is better by more than 1/32,
+  *         so a single error does not make the size flap. Once 2 * @YMODEM_ADAPT_WEIGHT packets
+  *         have been sent at the current size and less than one packet in @YMODEM_ADAPT_CLEAN
+  *         is expected to fail at the largest size, a larger size is taken without the margin.
+  *         A session starts at 1K, a packet that turns out too long is split by @transmitSplit.
+  * @return The data size offered to the callback.
+  */
+YMODEM_CORE_TEMPLATE
+uint32_t YMODEM_CORE::adaptPacketSize()
+{
+  uint32_t limit = (sessionHas(OptionExtended) == true) ? sessionSize : (uint32_t)(PacketSize);
+
+  if((adaptive != true) || (sessionHas(OptionStreaming) == true))
+  {
+    return limit;
+  }
+
+  if((adaptSize == 0) || (adaptSize > limit))
+  {
+    adaptSize = (limit < PacketSize) ? limit : (uint32_t)(PacketSize);
+  }
+
+  if(adaptCount >= YMODEM_ADAPT_PERIOD)
+  {
+    uint32_t sizes[3] = {YMODEM_PACKET_SIZE, PacketSize, limit};
+    bool     clean    = (adaptCount >= 2 * YMODEM_ADAPT_WEIGHT) &&
+                        ((1.0 - pow(1.0 - adaptRate, (double)(limit))) < (1.0 / YMODEM_ADAPT_CLEAN));
+    uint32_t best     = adaptSize;
+    double   goodput  = adaptGoodput(adaptSize) * ((clean == true) ? 1.0 : (1.0 + 1.0 / 32));
+
+    for(uint32_t i = 0; i < 3; i++)
+    {
+      if(adaptGoodput(sizes[i]) > goodput)
+      {
+        best    = sizes[i];
+        goodput = adaptGoodput(sizes[i]);
+      }
+    }
+
+    if(best != adaptSize)
+    {
+      adaptSize  = best;
+      adaptCount = 0;
+
+      stats.sizeChanges++;
+    }
+  }
+
+  stats.packetSize = adaptSize;
+
+  return adaptSize;
+}
+
+/**
+  * @brief  Update the estimated byte error rate of the line with a packet sent.
+  * @param  [in] length: The length of the packet.
+  * @param  [in] error:  Whether the packet was NAKed or timed out rather than acknowledged.
+  * @note   The failure rate of packets of this length is averaged over the last
+  *         @YMODEM_ADAPT_WEIGHT packets or so and converted back to a byte error rate,
+  *         so packets of any size update the same estimate.
+  * @return None.
+  */
+YMODEM_CORE_TEMPLATE
+void YMODEM_CORE::adaptUpdate(uint32_t length, bool error)
+{
+  double failure = 1.0 - pow(1.0 - adaptRate, (double)(length));
+
+  failure = failure + (((error == true) ? 1.0 : 0.0) - failure) / YMODEM_ADAPT_WEIGHT;
+  failure = (failure < 0.999) ? failure : 0.999;
+
+  adaptRate  = 1.0 - pow(1.0 - failure, 1.0 / length);
+  adaptCount = adaptCount + 1;
+}
+
+/**
+  * @brief  Get the expected goodput of a data size at the estimated byte error rate.
+  * @param  [in] size: The data size.
+  * @note   Every attempt costs the packet, its ACK and the turnaround before the next packet,
+  *         taken as @YMODEM_ADAPT_TURNAROUND bytes of line time for the receiver to check the
+  *         packet and the ACK to clear the UART FIFOs. A window session keeps sending during
+  *         the turnaround and does not pay it. Only the attempts that arrive intact deliver data.
+  * @return The data bytes delivered per byte of line time.
+  */
+YMODEM_CORE_TEMPLATE
+double YMODEM_CORE::adaptGoodput(uint32_t size)
+{
+  uint32_t length     = size + ((size > YMODEM_PACKET_1K_SIZE) ? YMODEM_PACKET_EXT_OVERHEAD : PacketOverhead);
+  uint32_t turnaround = (sessionHas(OptionWindow) == true) ? 0 : YMODEM_ADAPT_TURNAROUND;
+
+  return size * pow(1.0 - adaptRate, (double)(length)) / (length + 1 + turnaround);
+}
+
+/**
+  * @brief  Write data to the peer and count what is sent.
+  * @param  [in] buff: The data to be written.
+  * @param  [in] len:  The length of the data to be written.
+  * @note   The NAK that answers EOT is part of the protocol and is not counted.
+  * @return The length written.
+  */
+YMODEM_CORE_TEMPLATE
+uint32_t YMODEM_CORE::send(uint8_t *buff, uint32_t len)
+{
+  if((len >= YMODEM_PACKET_SIZE + PacketOverhead) &&
+     ((buff[0] == CodeSoh) || (buff[0] == CodeStx) || (buff[0] == CodeEtx)))
+  {
+    uint8_t slot = YMODEM_WINDOW_SLOT(buff[1]);
+
+    if((rttState[slot] != YMODEM_RTT_IDLE) && (rttNumber[slot] == buff[1]))
+    {
+      rttState[slot] = YMODEM_RTT_RESENT;
+    }
+    else
+    {
+      rttStamp[slot]  = microTick();
+      rttNumber[slot] = buff[1];
+      rttState[slot]  = YMODEM_RTT_TIMED;
+    }
+
+    txSendStamp = microTick();
+
+    stats.packetsSent++;
+
+    if(buff[0] == CodeSoh)
+    {
+      stats.packets128++;
+    }
+    else if(buff[0] == CodeStx)
+    {
+      stats.packets1K++;
+    }
+    else
+    {
+      stats.packetsExtended++;
+    }
+  }
+  else if(stage != StageFinishing)
+  {
+    uint32_t step = (sessionHas(OptionWindow) == true) ? 2 : 1;
+
+    for(uint32_t i = 0; (i < len) && (buff[i] == CodeNak); i += step)
+    {
+      stats.naks++;
+    }
+  }
+
+  return write(buff, len);
+}
+
+/**
+  * @brief  Call the callback and count the time spent in it.
+  * @param  [in]     status: The status passed to the callback.
+  * @param  [in,out] buff:   The buffer passed to the callback.
+  * @param  [in,out] len:    The length passed to the callback.
+  * @return The code returned by the callback.
+  */
+YMODEM_CORE_TEMPLATE
+YmodemBase::Code YMODEM_CORE::notify(Status status, uint8_t *buff, uint32_t *len)
+{
+  uint64_t start = microTick();
+
+  if((status != StatusEstablish) && (status != StatusTransmit) && (status != StatusResume))
+  {
+    statsStop = start;
+  }
+
+  Code result = callback(status, buff, len);
+
+  stats.callbackTime += microTick() - start;
+  stats.callbackCount++;
+
+  if((status == StatusTransmit) && (result == CodeAck))
+  {
+    stats.bytes += *len;
+  }
+  else if(result == CodeCan)
+  {
+    statsStop = start;
+  }
+
+  return result;
+}
+
+/**
+  * @brief  Reset the statistics when a session starts.
+  * @param  None.
+  * @return None.
+  */
+YMODEM_CORE_TEMPLATE
+void YMODEM_CORE::statsReset()
+{
+  memset(&stats, 0, sizeof(stats));
+  memset(rttHistogram, 0, sizeof(rttHistogram));
+  memset(rttStamp, 0, sizeof(rttStamp));
+  memset(rttNumber, 0, sizeof(rttNumber));
+  memset(rttState, YMODEM_RTT_IDLE, sizeof(rttState));
+
+  statsStart = microTick();
+  statsStop  = UINT64_MAX;
+  rttSum     = 0;
+}
+
+/**
+  * @brief  Time the round trip of an acknowledged data packet.
+  * @param  [in] number: The packet number acknowledged.
+  * @return None.
+  */
+YMODEM_CORE_TEMPLATE
+void YMODEM_CORE::statsAcknowledge(uint8_t number)
+{
+  uint8_t slot = YMODEM_WINDOW_SLOT(number);
+
+  if(rttNumber[slot] == number)
+  {
+    if(rttState[slot] == YMODEM_RTT_TIMED)
+    {
+      uint64_t rtt   = microTick() - rttStamp[slot];
+      uint32_t value = (rtt < UINT32_MAX) ? (uint32_t)(rtt) : UINT32_MAX;
+
+      if((stats.rttCount == 0) || (value < stats.rttMin))
+      {
+        stats.rttMin = value;
+      }
+
+      if(value > stats.rttMax)
+      {
+        stats.rttMax = value;
+      }
+
+      stats.rttCount++;
+      rttSum += value;
+      rttHistogram[rttBucket(value)]++;
+    }
+
+    rttState[slot] = YMODEM_RTT_IDLE;
+  }
+}
+
+/**
+  * @brief  Get the number of retransmission intervals elapsed in the current stage.
+  * @param  None.
+  * @return The number of retransmission intervals elapsed.
+  */
+YMODEM_CORE_TEMPLATE
+uint32_t YMODEM_CORE::timeUpdate()
+{
+  return (tick() - timeStamp) / ((timeDivide + 1) * timeUnit);
+}
+
+/**
+  * @brief  Calculate CRC16 checksum.
+  * @param  [in] buff: The data to be calculated.
+  * @param  [in] len:  The length of the data to be calculated.
+  * @return Calculated CRC16 checksum.
+  */
+YMODEM_CORE_TEMPLATE
+uint16_t YMODEM_CORE::crc16(uint8_t *buff, uint32_t len)
+{
+  return ::crc16(crcEngine, 0, buff, len);
+}
+
+#endif /* __YMODEM_CORE_H */
@@ -0,0 +1,472 @@
+/**
+  ******************************************************************************
+  * @file    YmodemDelta.cpp
+  * @author  SerialPortYmodem contributors
+  * @version v1.0
+  * @date    17-October-2026
+  * @brief   Block-level delta encoding against a base file.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>Copyright &copy; 2026 SerialPortYmodem contributors</center></h2>
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#include "YmodemDelta.h"
+#include "Crc32.h"
+#include <QFile>
+#include <QtEndian>
+#include <string.h>
+
+#define DELTA_LITERAL_SIZE  (64 * 1024)
+#define DELTA_COPY_SIZE     (1024 * 1024)
+#define DELTA_RECORD_SIZE   (9)
+#define DELTA_FLAG          (0x80000000UL)
+#define DELTA_COPY          ('C')
+#define DELTA_LITERAL       ('L')
+
+static bool readBase(const QString &name, QByteArray *base, quint32 *crc)
+{
+    base->clear();
+
+    *crc = 0;
+
+    if(name.isEmpty() == true)
+    {
+        return true;
+    }
+
+    QFile file(name);
+
+    if(file.exists() != true)
+    {
+        return true;
+    }
+
+    if(file.open(QFile::ReadOnly) != true)
+    {
+        return false;
+    }
+
+    *base = file.readAll();
+    *crc  = crc32Slice8(0, (const uint8_t *)base->constData(), base->size());
+
+    bool result = base->size() == file.size();
+
+    file.close();
+
+    return result;
+}
+
+YmodemDeltaEncoder::YmodemDeltaEncoder() :
+    baseCrc(0),
+    position(0),
+    literal(0),
+    rolling(false),
+    sumA(0),
+    sumB(0),
+    copyStart(0),
+    copyCount(0),
+    bufferPosition(0)
+{
+}
+
+bool YmodemDeltaEncoder::setBase(const QString &name)
+{
+    bool result = readBase(name, &base, &baseCrc);
+
+    index.clear();
+    chain.fill(-1, base.size() / DELTA_BLOCK_SIZE);
+
+    for(int i = chain.size() - 1; i >= 0; i--)
+    {
+        const uchar *data = (const uchar *)base.constData() + i * DELTA_BLOCK_SIZE;
+        quint32      a    = 0;
+        quint32      b    = 0;
+
+        for(int j = 0; j < DELTA_BLOCK_SIZE; j++)
+        {
+            a += data[j];
+            b += (DELTA_BLOCK_SIZE - j) * data[j];
+        }
+
+        quint32 weak = (a & 0xFFFF) | ((b & 0xFFFF) << 16);
+
+        chain[i] = index.value(weak, -1);
+        index.insert(weak, i);
+    }
+
+    return result;
+}
+
+bool YmodemDeltaEncoder::hasBase() const
+{
+    return base.isEmpty() != true;
+}
+
+void YmodemDeltaEncoder::reset(quint32 crc)
+{
+    uchar header[DELTA_HEADER_SIZE];
+
+    pending.clear();
+    buffer.clear();
+
+    position       = 0;
+    literal        = 0;
+    rolling        = false;
+    copyStart      = 0;
+    copyCount      = 0;
+    bufferPosition = 0;
+
+    qToBigEndian<quint64>(base.size(), &(header[0]));
+    qToBigEndian<quint32>(baseCrc, &(header[8]));
+    qToBigEndian<quint32>(DELTA_BLOCK_SIZE, &(header[12]));
+    qToBigEndian<quint32>(crc, &(header[16]));
+
+    buffer.append((const char *)header, DELTA_HEADER_SIZE);
+}
+
+void YmodemDeltaEncoder::encode(const char *data, int size, bool last)
+{
+    pending.append(data, size);
+
+    const uchar *bytes = (const uchar *)pending.constData();
+
+    /* Every block-sized window is looked up by its rolling checksum and compared with the base,
+     * so a block is found at any offset. The bytes in between are sent as literals. */
+    while((pending.size() - position) >= DELTA_BLOCK_SIZE)
+    {
+        if(rolling != true)
+        {
+            sumA = 0;
+            sumB = 0;
+
+            for(int j = 0; j < DELTA_BLOCK_SIZE; j++)
+            {
+                sumA += bytes[position + j];
+                sumB += (DELTA_BLOCK_SIZE - j) * bytes[position + j];
+            }
+
+            rolling = true;
+        }
+
+        int match = find(pending.constData() + position, (sumA & 0xFFFF) | ((sumB & 0xFFFF) << 16));
+
+        if(match >= 0)
+        {
+            flushLiteral(pending.constData() + literal, position - literal);
+
+            if((copyCount > 0) && (match == (copyStart + copyCount)) &&
+               (((copyCount + 1) * DELTA_BLOCK_SIZE) <= DELTA_COPY_SIZE))
+            {
+                copyCount++;
+            }
+            else
+            {
+                flushCopy();
+
+                copyStart = match;
+                copyCount = 1;
+            }
+
+            position += DELTA_BLOCK_SIZE;
+            literal   = position;
+            rolling   = false;
+        }
+        else
+        {
+            if((position + DELTA_BLOCK_SIZE) < pending.size())
+            {
+                sumA = sumA - bytes[position] + bytes[position + DELTA_BLOCK_SIZE];
+                sumB = sumB - DELTA_BLOCK_SIZE * bytes[position] + sumA;
+            }
+            else
+            {
+                rolling = false;
+            }
+
+            position++;
+
+            if((position - literal) >= DELTA_LITERAL_SIZE)
+            {
+                flushLiteral(pending.constData() + literal, position - literal);
+
+                literal = position;
+            }
+        }
+    }
+
+    if(last == true)
+    {
+        flushLiteral(pending.constData() + literal, pending.size() - literal);
+        flushCopy();
+
+        pending.clear();
+
+        position = 0;
+        literal  = 0;
+        rolling  = false;
+    }
+    else if(literal > 0)
+    {
+        pending.remove(0, literal);
+
+        position -= literal;
+        literal   = 0;
+    }
+}
+
+int YmodemDeltaEncoder::available() const
+{
+    return buffer.size() - bufferPosition;
+}
+
+int YmodemDeltaEncoder::take(char *data, int maxSize)
+{
+    int size = qMin(maxSize, available());
+
+    memcpy(data, buffer.constData() + bufferPosition, size);
+
+    bufferPosition += size;
+
+    if(bufferPosition == buffer.size())
+    {
+        buffer.clear();
+
+        bufferPosition = 0;
+    }
+    else if(bufferPosition >= DELTA_LITERAL_SIZE)
+    {
+        buffer.remove(0, bufferPosition);
+
+        bufferPosition = 0;
+    }
+
+    return size;
+}
+
+int YmodemDeltaEncoder::find(const char *data, quint32 weak)
+{
+    int next = copyStart + copyCount;
+
+    /* Try the block after the last copied one first, so unchanged runs stay in one copy record. */
+    if((copyCount > 0) && (next < chain.size()) &&
+       (memcmp(base.constData() + next * DELTA_BLOCK_SIZE, data, DELTA_BLOCK_SIZE) == 0))
+    {
+        return next;
+    }
+
+    for(int i = index.value(weak, -1); i >= 0; i = chain.at(i))
+    {
+        if(memcmp(base.constData() + i * DELTA_BLOCK_SIZE, data, DELTA_BLOCK_SIZE) == 0)
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+void YmodemDeltaEncoder::flushCopy()
+{
+    if(copyCount > 0)
+    {
+        uchar record[DELTA_RECORD_SIZE];
+
+        record[0] = DELTA_COPY;
+
+        qToBigEndian<quint32>(copyStart, &(record[1]));
+        qToBigEndian<quint32>(copyCount, &(record[5]));
+
+        buffer.append((const char *)record, DELTA_RECORD_SIZE);
+
+        copyCount = 0;
+    }
+}
+
+void YmodemDeltaEncoder::flushLiteral(const char *data, int size)
+{
+    if(size > 0)
+    {
+        flushCopy();
+    }
+
+    while(size > 0)
+    {
+        int        length     = qMin(size, DELTA_LITERAL_SIZE);
+        QByteArray packed     = qCompress((const uchar *)data, length);
+        bool       compressed = packed.size() < length;
+        uchar      record[DELTA_RECORD_SIZE];
+
+        record[0] = DELTA_LITERAL;
+
+        qToBigEndian<quint32>(length | ((compressed == true) ? DELTA_FLAG : 0), &(record[1]));
+        qToBigEndian<quint32>((compressed == true) ? packed.size() : length, &(record[5]));
+
+        buffer.append((const char *)record, DELTA_RECORD_SIZE);
+        buffer.append((compressed == true) ? packed.constData() : data, (compressed == true) ? packed.size() : length);
+
+        data += length;
+        size -= length;
+    }
+}
+
+YmodemDeltaDecoder::YmodemDeltaDecoder() :
+    baseCrc(0),
+    remain(0),
+    header(false),
+    based(false),
+    blockSize(0),
+    crc(0)
+{
+}
+
+bool YmodemDeltaDecoder::setBase(const QString &name)
+{
+    /* The base is read into memory, so it may be the file that is being received. */
+    return readBase(name, &base, &baseCrc);
+}
+
+void YmodemDeltaDecoder::reset(quint64 size)
+{
+    buffer.clear();
+
+    remain    = size;
+    header    = false;
+    based     = false;
+    blockSize = 0;
+    crc       = 0;
+}
+
+bool YmodemDeltaDecoder::decode(const char *data, int size, QByteArray *output)
+{
+    /* The bytes after the last record are only the padding of the last packet. */
+    if(remain == 0)
+    {
+        return true;
+    }
+
+    buffer.append(data, size);
+
+    if(header != true)
+    {
+        if(buffer.size() < DELTA_HEADER_SIZE)
+        {
+            return true;
+        }
+
+        const uchar *bytes    = (const uchar *)buffer.constData();
+        quint64      baseSize = qFromBigEndian<quint64>(&(bytes[0]));
+
+        blockSize = qFromBigEndian<quint32>(&(bytes[12]));
+        crc       = qFromBigEndian<quint32>(&(bytes[16]));
+        header    = true;
+        based     = baseSize != 0;
+
+        /* A stream made without a base is accepted by any receiver, otherwise the bases must match. */
+        if(((baseSize != 0) && ((baseSize != (quint64)(base.size())) || (qFromBigEndian<quint32>(&(bytes[8])) != baseCrc))) ||
+           (blockSize == 0) || (blockSize > DELTA_COPY_SIZE))
+        {
+            return false;
+        }
+
+        buffer.remove(0, DELTA_HEADER_SIZE);
+    }
+
+    while(buffer.size() >= DELTA_RECORD_SIZE)
+    {
+        const uchar *record = (const uchar *)buffer.constData();
+        quint32      first  = qFromBigEndian<quint32>(&(record[1]));
+        quint32      second = qFromBigEndian<quint32>(&(record[5]));
+
+        if(record[0] == DELTA_COPY)
+        {
+            quint64 offset = (quint64)(first) * blockSize;
+            quint64 length = (quint64)(second) * blockSize;
+
+            if((length == 0) || (length > DELTA_COPY_SIZE) || (length > remain) ||
+               ((offset + length) > (quint64)(base.size())))
+            {
+                return false;
+            }
+
+            output->append(base.constData() + offset, (int)(length));
+            buffer.remove(0, DELTA_RECORD_SIZE);
+
+            remain -= length;
+        }
+        else if(record[0] == DELTA_LITERAL)
+        {
+            quint32 length     = first & ~DELTA_FLAG;
+            bool    compressed = (first & DELTA_FLAG) != 0;
+
+            if((length == 0) || (length > DELTA_LITERAL_SIZE) || (length > remain) ||
+               ((compressed == true) ? (second >= length) : (second != length)))
+            {
+                return false;
+            }
+
+            if((quint32)(buffer.size() - DELTA_RECORD_SIZE) < second)
+            {
+                break;
+            }
+
+            if(compressed == true)
+            {
+                QByteArray chunk = qUncompress(&(record[DELTA_RECORD_SIZE]), second);
+
+                if((quint32)(chunk.size()) != length)
+                {
+                    return false;
+                }
+
+                output->append(chunk);
+            }
+            else
+            {
+                output->append((const char *)&(record[DELTA_RECORD_SIZE]), length);
+            }
+
+            buffer.remove(0, DELTA_RECORD_SIZE + second);
+
+            remain -= length;
+        }
+        else
+        {
+            return false;
+        }
+
+        if(remain == 0)
+        {
+            buffer.clear();
+
+            break;
+        }
+    }
+
+    return true;
+}
+
+bool YmodemDeltaDecoder::hasBase() const
+{
+    return based;
+}
+
+quint32 YmodemDeltaDecoder::getCrc() const
+{
+    return crc;
+}
@@ -0,0 +1,111 @@
+/**
+  ******************************************************************************
+  * @file    YmodemDelta.h
+  * @author  SerialPortYmodem contributors
+  * @version v1.0
+  * @date    17-October-2026
+  * @brief   Header file for YmodemDelta.cpp module.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>Copyright &copy; 2026 SerialPortYmodem contributors</center></h2>
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#ifndef YMODEMDELTA_H
+#define YMODEMDELTA_H
+
+#include <QHash>
+#include <QVector>
+#include <QString>
+#include <QByteArray>
+
+#define DELTA_BLOCK_SIZE    (2048)
+#define DELTA_HEADER_SIZE   (20)
+
+/*
+ * The data stream of an OptionDelta session rebuilds the file from a base file both ends
+ * already hold. It starts with a 20-byte big-endian header: the base size (8 bytes), the
+ * CRC32 of the base, the block size and the CRC32 of the whole new file, which is only
+ * checked for a stream made from a base and is 0 without one. Records follow:
+ * 'C' with a block index and count copies blocks of the base, 'L' carries literal bytes
+ * behind their length (top bit set when compressed with qCompress) and payload length.
+ */
+class YmodemDeltaEncoder
+{
+public:
+    YmodemDeltaEncoder();
+
+    bool setBase(const QString &name);
+    bool hasBase() const;
+
+    void reset(quint32 crc);
+    void encode(const char *data, int size, bool last);
+
+    int available() const;
+    int take(char *data, int maxSize);
+
+private:
+    int find(const char *data, quint32 weak);
+
+    void flushCopy();
+    void flushLiteral(const char *data, int size);
+
+    QByteArray          base;
+    quint32             baseCrc;
+    QHash<quint32, int> index;
+    QVector<int>        chain;
+
+    QByteArray pending;
+    int        position;
+    int        literal;
+    bool       rolling;
+    quint32    sumA;
+    quint32    sumB;
+    int        copyStart;
+    int        copyCount;
+
+    QByteArray buffer;
+    int        bufferPosition;
+};
+
+class YmodemDeltaDecoder
+{
+public:
+    YmodemDeltaDecoder();
+
+    bool setBase(const QString &name);
+
+    void reset(quint64 size);
+    bool decode(const char *data, int size, QByteArray *output);
+
+    bool hasBase() const;
+    quint32 getCrc() const;
+
+private:
+    QByteArray base;
+    quint32    baseCrc;
+
+    QByteArray buffer;
+    quint64    remain;
+    bool       header;
+    bool       based;
+    quint32    blockSize;
+    quint32    crc;
+};
+
+#endif // YMODEMDELTA_H
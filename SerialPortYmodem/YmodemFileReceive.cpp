@@ -1,34 +1,41 @@
 #include "YmodemFileReceive.h"
+#include <QSaveFile>
 
-#define READ_TIME_OUT   (10)
-#define WRITE_TIME_OUT  (100)
+#define WRITE_TIME_OUT      (100)
+#define JOURNAL_SUFFIX      ".journal"
+#define JOURNAL_INTERVAL    (1024 * 1024)
+#define READ_BUFFER_SIZE    (64 * 1024)
 
 YmodemFileReceive::YmodemFileReceive(QObject *parent) :
     QObject(parent),
-    file(new QFile),
-    readTimer(new QTimer),
-    writeTimer(new QTimer),
-    serialPort(new QSerialPort)
+    file(new YmodemFileSink),
+    deadlineTimer(new QTimer(this)),
+    writeTimer(new QTimer(this)),
+    serialPort(new QSerialPort(this)),
+    portName("COM1"),
+    portBaudRate(115200)
 {
     setTimeDivide(499);
     setTimeMax(5);
     setErrorMax(999);
 
-    serialPort->setPortName("COM1");
-    serialPort->setBaudRate(115200);
     serialPort->setDataBits(QSerialPort::Data8);
     serialPort->setStopBits(QSerialPort::OneStop);
     serialPort->setParity(QSerialPort::NoParity);
     serialPort->setFlowControl(QSerialPort::NoFlowControl);
+    serialPort->setReadBufferSize(READ_BUFFER_SIZE);
 
-    connect(readTimer, SIGNAL(timeout()), this, SLOT(readTimeOut()));
+    deadlineTimer->setSingleShot(true);
+
+    connect(serialPort, SIGNAL(readyRead()), this, SLOT(readyRead()));
+    connect(deadlineTimer, SIGNAL(timeout()), this, SLOT(deadlineTimeOut()));
     connect(writeTimer, SIGNAL(timeout()), this, SLOT(writeTimeOut()));
 }
 
 YmodemFileReceive::~YmodemFileReceive()
 {
     delete file;
-    delete readTimer;
+    delete deadlineTimer;
     delete writeTimer;
     delete serialPort;
 }
@@ -38,24 +45,71 @@ void YmodemFileReceive::setFilePath(const QString &path)
     filePath = path + "/";
 }
 
+void YmodemFileReceive::setBaseFilePath(const QString &path)
+{
+    basePath = path.isEmpty() ? QString() : (path + "/");
+}
+
 void YmodemFileReceive::setPortName(const QString &name)
 {
-    serialPort->setPortName(name);
+    portName = name;
 }
 
 void YmodemFileReceive::setPortBaudRate(qint32 baudrate)
 {
-    serialPort->setBaudRate(baudrate);
+    portBaudRate = baudrate;
 }
 
 bool YmodemFileReceive::startReceive()
 {
-    progress = 0;
-    status   = StatusEstablish;
+    bool result = false;
+
+    cancel.storeRelease(0);
+
+    if(QThread::currentThread() == thread())
+    {
+        return openReceive();
+    }
+
+    QMetaObject::invokeMethod(this, "openReceive", Qt::BlockingQueuedConnection, Q_RETURN_ARG(bool, result));
+
+    return result;
+}
+
+void YmodemFileReceive::stopReceive()
+{
+    cancel.storeRelease(1);
+
+    QMetaObject::invokeMethod(this, "abortReceive", Qt::QueuedConnection);
+}
+
+int YmodemFileReceive::getReceiveProgress()
+{
+    return progress.loadAcquire();
+}
+
+Ymodem::Status YmodemFileReceive::getReceiveStatus()
+{
+    return (Status)(status.loadAcquire());
+}
+
+quint64 YmodemFileReceive::getReceiveBytes()
+{
+    return bytes.loadAcquire();
+}
+
+bool YmodemFileReceive::openReceive()
+{
+    progress.storeRelease(0);
+    status.storeRelease(StatusEstablish);
+    bytes.storeRelease(0);
+
+    serialPort->setPortName(portName);
+    serialPort->setBaudRate(portBaudRate);
 
     if(serialPort->open(QSerialPort::ReadWrite) == true)
     {
-        readTimer->start(READ_TIME_OUT);
+        deadlineTimer->start(0);
 
         return true;
     }
@@ -65,33 +119,52 @@ bool YmodemFileReceive::startReceive()
     }
 }
 
-void YmodemFileReceive::stopReceive()
+void YmodemFileReceive::abortReceive()
 {
-    file->close();
-    abort();
-    status = StatusAbort;
-    writeTimer->start(WRITE_TIME_OUT);
+    if(isActive() == true)
+    {
+        saveJournal();
+        file->close();
+        abort();
+        status.storeRelease(StatusAbort);
+        deadlineTimer->stop();
+        writeTimer->start(WRITE_TIME_OUT);
+    }
 }
 
-int YmodemFileReceive::getReceiveProgress()
+bool YmodemFileReceive::isActive()
 {
-    return progress;
+    return (status.loadAcquire() == StatusEstablish) || (status.loadAcquire() == StatusTransmit);
 }
 
-Ymodem::Status YmodemFileReceive::getReceiveStatus()
+void YmodemFileReceive::readyRead()
 {
-    return status;
+    while((serialPort->bytesAvailable() > 0) && (cancel.loadAcquire() == 0) && (isActive() == true))
+    {
+        receive();
+    }
+
+    if(isActive() == true)
+    {
+        deadlineTimer->start(getTimeToDeadline());
+    }
+    else
+    {
+        deadlineTimer->stop();
+    }
 }
 
-void YmodemFileReceive::readTimeOut()
+void YmodemFileReceive::deadlineTimeOut()
 {
-    readTimer->stop();
-
     receive();
 
-    if((status == StatusEstablish) || (status == StatusTransmit))
+    if(isActive() == true)
+    {
+        deadlineTimer->start(getTimeToDeadline());
+    }
+    else
     {
-        readTimer->start(READ_TIME_OUT);
+        deadlineTimer->stop();
     }
 }
 
@@ -99,7 +172,8 @@ void YmodemFileReceive::writeTimeOut()
 {
     writeTimer->stop();
     serialPort->close();
-    receiveStatus(status);
+    receiveStats(getTransferStats());
+    receiveStatus((Status)(status.loadAcquire()));
 }
 
 Ymodem::Code YmodemFileReceive::callback(Status status, uint8_t *buff, uint32_t *len)
@@ -129,14 +203,26 @@ Ymodem::Code YmodemFileReceive::callback(Status status, uint8_t *buff, uint32_t
                 fileName  = QString::fromLocal8Bit(name);
                 QString file_desc(size);
                 QString sizeStr = file_desc.left(file_desc.indexOf(' '));
-                fileSize  = sizeStr.toULongLong();
-                fileCount = 0;
-
+                QString timeStr = file_desc.section(' ', 1, 1);
+                fileSize   = sizeStr.toULongLong();
+                fileTime   = timeStr.toULongLong(0, 8);
+                fileCount  = 0;
+                fileCommit = 0;
+                fileHash   = 0;
+
+                file->close();
                 file->setFileName(filePath + fileName);
 
-                if(file->open(QFile::WriteOnly) == true)
+                /* The base is loaded first, it may be the file that is about to be overwritten. */
+                if(((encoding() != OptionDelta) ||
+                    (deltaDecoder.setBase(basePath.isEmpty() ? QString() : (basePath + fileName)) == true)) &&
+                   ((((getSessionOptions() & OptionResume) != 0) && (resumeFile() == true)) || (file->open(0) == true)) &&
+                   (file->preallocate(fileSize) == true))
                 {
-                    YmodemFileReceive::status = StatusEstablish;
+                    compressDecoder.reset(fileSize - fileCount);
+                    deltaDecoder.reset(fileSize - fileCount);
+
+                    YmodemFileReceive::status.storeRelease(StatusEstablish);
 
                     receiveStatus(StatusEstablish);
 
@@ -144,7 +230,9 @@ Ymodem::Code YmodemFileReceive::callback(Status status, uint8_t *buff, uint32_t
                 }
                 else
                 {
-                    YmodemFileReceive::status = StatusError;
+                    file->close();
+
+                    YmodemFileReceive::status.storeRelease(StatusError);
 
                     writeTimer->start(WRITE_TIME_OUT);
 
@@ -153,7 +241,7 @@ Ymodem::Code YmodemFileReceive::callback(Status status, uint8_t *buff, uint32_t
             }
             else
             {
-                YmodemFileReceive::status = StatusError;
+                YmodemFileReceive::status.storeRelease(StatusError);
 
                 writeTimer->start(WRITE_TIME_OUT);
 
@@ -163,34 +251,107 @@ Ymodem::Code YmodemFileReceive::callback(Status status, uint8_t *buff, uint32_t
 
         case StatusTransmit:
         {
-            if((fileSize - fileCount) > *len)
+            if(cancel.loadAcquire() != 0)
             {
-                file->write((char *)buff, *len);
+                saveJournal();
+                file->close();
+
+                YmodemFileReceive::status.storeRelease(StatusAbort);
 
-                fileCount += *len;
+                writeTimer->start(WRITE_TIME_OUT);
+
+                return CodeCan;
             }
-            else
+
+            const uint8_t *data   = buff;
+            uint32_t       length = ((fileSize - fileCount) > *len) ? *len : (uint32_t)(fileSize - fileCount);
+            uint32_t       mode   = encoding();
+            bool           result = true;
+
+            if(mode != OptionNone)
+            {
+                chunk.clear();
+
+                result = (mode == OptionDelta) ? deltaDecoder.decode((const char *)buff, *len, &chunk) :
+                                                 compressDecoder.decode((const char *)buff, *len, &chunk);
+                data   = (const uint8_t *)chunk.constData();
+                length = chunk.size();
+            }
+
+            result = (result == true) && (file->write((const char *)data, length) == true);
+
+            fileCount += length;
+            bytes.fetchAndAddRelease(length);
+            fileHash   = crc32Slice8(fileHash, data, length);
+
+            if((result == true) && (fileCount == fileSize))
+            {
+                result = ((mode != OptionDelta) || (deltaDecoder.hasBase() != true) || (fileHash == deltaDecoder.getCrc())) &&
+                         (file->flush() == true);
+
+                if(result == true)
+                {
+                    QFile::remove(file->fileName() + JOURNAL_SUFFIX);
+
+                    fileCommit = fileCount;
+                }
+            }
+            else if((result == true) && ((fileCount - fileCommit) >= JOURNAL_INTERVAL))
             {
-                file->write((char *)buff, fileSize - fileCount);
+                result = saveJournal();
+            }
+
+            if(result != true)
+            {
+                file->close();
+
+                YmodemFileReceive::status.storeRelease(StatusError);
 
-                fileCount += fileSize - fileCount;
+                writeTimer->start(WRITE_TIME_OUT);
+
+                return CodeCan;
             }
 
-            progress = (int)(fileCount * 100 / fileSize);
+            int value = (int)(fileCount * 100 / fileSize);
 
-            YmodemFileReceive::status = StatusTransmit;
+            if(YmodemFileReceive::progress.fetchAndStoreRelease(value) != value)
+            {
+                receiveProgress(value);
+            }
 
-            receiveProgress(progress);
-            receiveStatus(StatusTransmit);
+            if(YmodemFileReceive::status.fetchAndStoreRelease(StatusTransmit) != StatusTransmit)
+            {
+                receiveStatus(StatusTransmit);
+            }
 
             return CodeAck;
         }
 
-        case StatusFinish:
+        case StatusResume:
         {
-            file->close();
+            if(fileCount != 0)
+            {
+                uint64_t offset = fileCount;
 
-            YmodemFileReceive::status = StatusFinish;
+                for(int i = YMODEM_RESUME_SIZE - 1; i >= 0; i--)
+                {
+                    buff[i]   = (uint8_t)(offset);
+                    offset  >>= 8;
+                }
+
+                *len = YMODEM_RESUME_SIZE;
+
+                return CodeAck;
+            }
+            else
+            {
+                return CodeNak;
+            }
+        }
+
+        case StatusFinish:
+        {
+            YmodemFileReceive::status.storeRelease((file->close() == true) ? StatusFinish : StatusError);
 
             writeTimer->start(WRITE_TIME_OUT);
 
@@ -199,9 +360,10 @@ Ymodem::Code YmodemFileReceive::callback(Status status, uint8_t *buff, uint32_t
 
         case StatusAbort:
         {
+            saveJournal();
             file->close();
 
-            YmodemFileReceive::status = StatusAbort;
+            YmodemFileReceive::status.storeRelease(StatusAbort);
 
             writeTimer->start(WRITE_TIME_OUT);
 
@@ -210,7 +372,9 @@ Ymodem::Code YmodemFileReceive::callback(Status status, uint8_t *buff, uint32_t
 
         case StatusTimeout:
         {
-            YmodemFileReceive::status = StatusTimeout;
+            saveJournal();
+
+            YmodemFileReceive::status.storeRelease(StatusTimeout);
 
             writeTimer->start(WRITE_TIME_OUT);
 
@@ -219,9 +383,10 @@ Ymodem::Code YmodemFileReceive::callback(Status status, uint8_t *buff, uint32_t
 
         default:
         {
+            saveJournal();
             file->close();
 
-            YmodemFileReceive::status = StatusError;
+            YmodemFileReceive::status.storeRelease(StatusError);
 
             writeTimer->start(WRITE_TIME_OUT);
 
@@ -230,6 +395,14 @@ Ymodem::Code YmodemFileReceive::callback(Status status, uint8_t *buff, uint32_t
     }
 }
 
+uint32_t YmodemFileReceive::encoding()
+{
+    uint32_t session = getSessionOptions();
+
+    /* A delta already compresses its literals. */
+    return ((session & OptionDelta) != 0) ? OptionDelta : (session & OptionCompress);
+}
+
 uint32_t YmodemFileReceive::read(uint8_t *buff, uint32_t len)
 {
     return serialPort->read((char *)buff, len);
@@ -239,3 +412,89 @@ uint32_t YmodemFileReceive::write(uint8_t *buff, uint32_t len)
 {
     return serialPort->write((char *)buff, len);
 }
+
+bool YmodemFileReceive::resumeFile()
+{
+    QFile journal(file->fileName() + JOURNAL_SUFFIX);
+
+    if(journal.open(QFile::ReadOnly) != true)
+    {
+        return false;
+    }
+
+    QList<QByteArray> fields = journal.readAll().split('\n');
+
+    journal.close();
+
+    /* Without the modification time the source may have changed since, the file starts over. */
+    if((fields.size() < 5) || (QString::fromUtf8(fields.at(0)) != fileName) || (fields.at(1).toULongLong() != fileSize) ||
+       (fileTime == 0) || (fields.at(4).toULongLong() != fileTime))
+    {
+        return false;
+    }
+
+    uint64_t commit = fields.at(2).toULongLong();
+    uint32_t hash   = fields.at(3).toUInt(0, 16);
+    uint32_t crc    = 0;
+    uint64_t count  = 0;
+
+    QFile partial(file->fileName());
+
+    if((commit == 0) || (commit > fileSize) || (partial.open(QFile::ReadOnly) != true))
+    {
+        return false;
+    }
+
+    while(count < commit)
+    {
+        QByteArray data = partial.read(qMin<uint64_t>(commit - count, JOURNAL_INTERVAL));
+
+        if(data.isEmpty() == true)
+        {
+            break;
+        }
+
+        crc    = crc32Slice8(crc, (const uint8_t *)data.constData(), data.size());
+        count += data.size();
+    }
+
+    partial.close();
+
+    if((count != commit) || (crc != hash) || (file->open(commit) != true))
+    {
+        return false;
+    }
+
+    fileCount  = commit;
+    fileCommit = commit;
+    fileHash   = hash;
+
+    return true;
+}
+
+bool YmodemFileReceive::saveJournal()
+{
+    if((file->isOpen() == true) && (fileCount != fileCommit))
+    {
+        /* The data must be on disk before the journal vouches for it, and the journal is
+           replaced by a rename so a crash leaves either the old or the new one. */
+        QSaveFile journal(file->fileName() + JOURNAL_SUFFIX);
+
+        if(file->sync() != true)
+        {
+            return false;
+        }
+
+        fileCommit = fileCount;
+
+        if(journal.open(QFile::WriteOnly) == true)
+        {
+            journal.write(fileName.toUtf8() + "\n" + QByteArray::number((quint64)(fileSize)) + "\n" +
+                          QByteArray::number((quint64)(fileCommit)) + "\n" + QByteArray::number(fileHash, 16) + "\n" +
+                          QByteArray::number((quint64)(fileTime)) + "\n");
+            journal.commit();
+        }
+    }
+
+    return true;
+}
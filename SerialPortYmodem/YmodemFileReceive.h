@@ -3,9 +3,14 @@
 
 #include <QFile>
 #include <QTimer>
+#include <QThread>
+#include <QAtomicInt>
 #include <QObject>
 #include <QSerialPort>
 #include "Ymodem.h"
+#include "YmodemFileSink.h"
+#include "YmodemCompress.h"
+#include "YmodemDelta.h"
 
 class YmodemFileReceive : public QObject, public Ymodem
 {
@@ -16,6 +21,7 @@ public:
     ~YmodemFileReceive();
 
     void setFilePath(const QString &path);
+    void setBaseFilePath(const QString &path);
 
     void setPortName(const QString &name);
     void setPortBaudRate(qint32 baudrate);
@@ -25,32 +31,58 @@ public:
 
     int getReceiveProgress();
     Status getReceiveStatus();
+    quint64 getReceiveBytes();
 
 signals:
     void receiveProgress(int progress);
     void receiveStatus(YmodemFileReceive::Status status);
+    void receiveStats(YmodemFileReceive::Stats stats);
 
 private slots:
-    void readTimeOut();
+    void readyRead();
+    void deadlineTimeOut();
     void writeTimeOut();
 
+    bool openReceive();
+    void abortReceive();
+
 private:
+    bool isActive();
+
     Code callback(Status status, uint8_t *buff, uint32_t *len);
 
+    uint32_t encoding();
+
+    bool resumeFile();
+    bool saveJournal();
+
     uint32_t read(uint8_t *buff, uint32_t len);
     uint32_t write(uint8_t *buff, uint32_t len);
 
-    QFile       *file;
-    QTimer      *readTimer;
-    QTimer      *writeTimer;
-    QSerialPort *serialPort;
-
-    int      progress;
-    Status   status;
-    QString  filePath;
-    QString  fileName;
-    uint64_t fileSize;
-    uint64_t fileCount;
+    YmodemFileSink *file;
+    QTimer         *deadlineTimer;
+    QTimer         *writeTimer;
+    QSerialPort    *serialPort;
+
+    QString    portName;
+    qint32     portBaudRate;
+    QAtomicInt progress;
+    QAtomicInt status;
+    QAtomicInt cancel;
+
+    QAtomicInteger<quint64> bytes;
+    QString    filePath;
+    QString    basePath;
+    QString    fileName;
+    uint64_t   fileSize;
+    uint64_t   fileTime;
+    uint64_t   fileCount;
+    uint64_t   fileCommit;
+    uint32_t   fileHash;
+
+    YmodemCompressDecoder compressDecoder;
+    YmodemDeltaDecoder    deltaDecoder;
+    QByteArray            chunk;
 };
 
 #endif // YMODEMFILERECEIVE_H
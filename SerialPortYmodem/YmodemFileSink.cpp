@@ -0,0 +1,257 @@
+/**
+  ******************************************************************************
+  * @file    YmodemFileSink.cpp
+  * @author  SerialPortYmodem contributors
+  * @version v1.0
+  * @date    16-October-2026
+  * @brief   Received file sink, written behind the protocol on its own thread.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>Copyright &copy; 2026 SerialPortYmodem contributors</center></h2>
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#include "YmodemFileSink.h"
+#include <string.h>
+
+#ifdef Q_OS_LINUX
+#include <errno.h>
+#include <fcntl.h>
+#endif
+
+#ifdef Q_OS_WIN
+#include <io.h>
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#define WRITE_BEHIND_SIZE   (1024 * 1024)
+#define WRITE_BEHIND_CHUNK  (256 * 1024)
+
+YmodemFileSink::YmodemFileSink(QObject *parent) :
+    QThread(parent),
+    file(new QFile),
+    position(0),
+    ringHead(0),
+    ringTail(0),
+    ringStop(true),
+    ringFlush(false),
+    ringError(false)
+{
+}
+
+YmodemFileSink::~YmodemFileSink()
+{
+    close();
+
+    delete file;
+}
+
+void YmodemFileSink::setFileName(const QString &name)
+{
+    close();
+
+    file->setFileName(name);
+}
+
+QString YmodemFileSink::fileName() const
+{
+    return file->fileName();
+}
+
+bool YmodemFileSink::open(qint64 offset)
+{
+    close();
+
+    if(file->open(QFile::ReadWrite | QFile::Unbuffered) != true)
+    {
+        return false;
+    }
+
+    if((file->resize(offset) != true) || (file->seek(offset) != true))
+    {
+        file->close();
+
+        return false;
+    }
+
+    if(ring.size() != WRITE_BEHIND_SIZE)
+    {
+        ring.resize(WRITE_BEHIND_SIZE);
+    }
+
+    position  = offset;
+    ringHead  = 0;
+    ringTail  = 0;
+    ringStop  = false;
+    ringFlush = false;
+    ringError = false;
+
+    start();
+
+    return true;
+}
+
+bool YmodemFileSink::close()
+{
+    if(file->isOpen() != true)
+    {
+        return true;
+    }
+
+    mutex.lock();
+
+    ringStop = true;
+
+    readable.wakeAll();
+    mutex.unlock();
+
+    wait();
+
+    file->close();
+
+    return ringError != true;
+}
+
+bool YmodemFileSink::isOpen() const
+{
+    return file->isOpen();
+}
+
+bool YmodemFileSink::preallocate(qint64 size)
+{
+#ifdef Q_OS_LINUX
+    if((size > position) && (fallocate(file->handle(), FALLOC_FL_KEEP_SIZE, position, size - position) != 0))
+    {
+        return errno != ENOSPC;
+    }
+#else
+    Q_UNUSED(size);
+#endif
+
+    return true;
+}
+
+bool YmodemFileSink::write(const char *data, qint64 size)
+{
+    QMutexLocker locker(&mutex);
+
+    qint64 count = 0;
+
+    while((count < size) && (ringError != true))
+    {
+        while(((ringHead - ringTail) == ring.size()) && (ringError != true))
+        {
+            writable.wait(&mutex);
+        }
+
+        qint64 offset = ringHead % ring.size();
+        qint64 length = qMin(qMin(size - count, ring.size() - (ringHead - ringTail)), ring.size() - offset);
+
+        memcpy(ring.data() + offset, data + count, length);
+
+        count    += length;
+        ringHead += length;
+
+        readable.wakeOne();
+    }
+
+    return ringError != true;
+}
+
+bool YmodemFileSink::flush()
+{
+    QMutexLocker locker(&mutex);
+
+    ringFlush = true;
+
+    readable.wakeOne();
+
+    while((ringHead != ringTail) && (ringError != true))
+    {
+        writable.wait(&mutex);
+    }
+
+    ringFlush = false;
+
+    return ringError != true;
+}
+
+bool YmodemFileSink::sync()
+{
+    if(flush() != true)
+    {
+        return false;
+    }
+
+#ifdef Q_OS_WIN
+    return FlushFileBuffers((HANDLE)(_get_osfhandle(file->handle()))) != 0;
+#else
+    return fsync(file->handle()) == 0;
+#endif
+}
+
+void YmodemFileSink::run()
+{
+    forever
+    {
+        qint64 tail   = 0;
+        qint64 length = 0;
+
+        mutex.lock();
+
+        /* Wait for a full aligned chunk unless the data is flushed or the sink is closed. */
+        while((ringError != true) && (ringStop != true) &&
+              ((ringHead - ringTail) < (WRITE_BEHIND_CHUNK - (position % WRITE_BEHIND_CHUNK))) &&
+              ((ringFlush != true) || (ringHead == ringTail)))
+        {
+            readable.wait(&mutex);
+        }
+
+        if((ringError == true) || (ringHead == ringTail))
+        {
+            mutex.unlock();
+
+            return;
+        }
+
+        tail   = ringTail;
+        length = qMin(qMin(ringHead - ringTail, WRITE_BEHIND_CHUNK - (position % WRITE_BEHIND_CHUNK)),
+                      ring.size() - (tail % ring.size()));
+
+        mutex.unlock();
+
+        qint64 number = file->write(ring.constData() + (tail % ring.size()), length);
+
+        mutex.lock();
+
+        if(number == length)
+        {
+            ringTail += length;
+            position += length;
+        }
+        else
+        {
+            ringError = true;
+        }
+
+        writable.wakeAll();
+        mutex.unlock();
+    }
+}
@@ -0,0 +1,75 @@
+/**
+  ******************************************************************************
+  * @file    YmodemFileSink.h
+  * @author  SerialPortYmodem contributors
+  * @version v1.0
+  * @date    16-October-2026
+  * @brief   Header file for YmodemFileSink.cpp module.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>Copyright &copy; 2026 SerialPortYmodem contributors</center></h2>
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#ifndef YMODEMFILESINK_H
+#define YMODEMFILESINK_H
+
+#include <QFile>
+#include <QMutex>
+#include <QThread>
+#include <QByteArray>
+#include <QWaitCondition>
+
+class YmodemFileSink : public QThread
+{
+    Q_OBJECT
+
+public:
+    explicit YmodemFileSink(QObject *parent = 0);
+    ~YmodemFileSink();
+
+    void setFileName(const QString &name);
+    QString fileName() const;
+
+    bool open(qint64 offset);
+    bool close();
+    bool isOpen() const;
+
+    bool preallocate(qint64 size);
+    bool write(const char *data, qint64 size);
+    bool flush();
+    bool sync();
+
+private:
+    void run();
+
+    QFile *file;
+    qint64 position;
+
+    QMutex         mutex;
+    QWaitCondition readable;
+    QWaitCondition writable;
+    QByteArray     ring;
+    qint64         ringHead;
+    qint64         ringTail;
+    bool           ringStop;
+    bool           ringFlush;
+    bool           ringError;
+};
+
+#endif // YMODEMFILESINK_H
@@ -0,0 +1,267 @@
+/**
+  ******************************************************************************
+  * @file    YmodemFileSource.cpp
+  * @author  SerialPortYmodem contributors
+  * @version v1.0
+  * @date    16-October-2026
+  * @brief   Transmitted file source, mapped or read ahead on its own thread.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>Copyright &copy; 2026 SerialPortYmodem contributors</center></h2>
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#include "YmodemFileSource.h"
+#include <string.h>
+
+#define READ_AHEAD_SIZE   (1024 * 1024)
+#define READ_AHEAD_CHUNK  (64 * 1024)
+
+YmodemFileSource::YmodemFileSource(QObject *parent) :
+    QThread(parent),
+    file(new QFile),
+    map(NULL),
+    fileSize(0),
+    position(0),
+    ringHead(0),
+    ringTail(0),
+    ringStop(true),
+    ringEnd(false)
+{
+}
+
+YmodemFileSource::~YmodemFileSource()
+{
+    close();
+
+    delete file;
+}
+
+void YmodemFileSource::setFileName(const QString &name)
+{
+    close();
+
+    file->setFileName(name);
+}
+
+QString YmodemFileSource::fileName() const
+{
+    return file->fileName();
+}
+
+bool YmodemFileSource::open()
+{
+    close();
+
+    if(file->open(QFile::ReadOnly) != true)
+    {
+        return false;
+    }
+
+    fileSize = file->size();
+    position = 0;
+
+    if((fileSize > 0) && (file->isSequential() != true))
+    {
+        map = file->map(0, fileSize);
+    }
+
+    if((map == NULL) && (fileSize > 0))
+    {
+        startReadAhead(0);
+    }
+
+    return true;
+}
+
+void YmodemFileSource::close()
+{
+    stopReadAhead();
+
+    if(map != NULL)
+    {
+        file->unmap(map);
+
+        map = NULL;
+    }
+
+    file->close();
+
+    fileSize = 0;
+    position = 0;
+}
+
+bool YmodemFileSource::isOpen() const
+{
+    return file->isOpen();
+}
+
+bool YmodemFileSource::isMapped() const
+{
+    return map != NULL;
+}
+
+qint64 YmodemFileSource::size() const
+{
+    return fileSize;
+}
+
+bool YmodemFileSource::seek(qint64 offset)
+{
+    if((file->isOpen() != true) || (offset < 0) || (offset > fileSize))
+    {
+        return false;
+    }
+
+    if((map == NULL) && (offset != position))
+    {
+        stopReadAhead();
+        startReadAhead(offset);
+    }
+
+    position = offset;
+
+    return true;
+}
+
+qint64 YmodemFileSource::read(char *data, qint64 maxSize)
+{
+    qint64 count = 0;
+
+    if(position >= fileSize)
+    {
+        return 0;
+    }
+    else if(map != NULL)
+    {
+        count = qMin(maxSize, fileSize - position);
+
+        memcpy(data, map + position, count);
+    }
+    else
+    {
+        QMutexLocker locker(&mutex);
+
+        while(count < maxSize)
+        {
+            while((ringHead == ringTail) && (ringEnd != true))
+            {
+                readable.wait(&mutex);
+            }
+
+            if(ringHead == ringTail)
+            {
+                break;
+            }
+
+            qint64 offset = ringTail % ring.size();
+            qint64 length = qMin(qMin(maxSize - count, ringHead - ringTail), ring.size() - offset);
+
+            memcpy(data + count, ring.constData() + offset, length);
+
+            count    += length;
+            ringTail += length;
+
+            writable.wakeOne();
+        }
+    }
+
+    position += count;
+
+    return count;
+}
+
+void YmodemFileSource::run()
+{
+    forever
+    {
+        qint64 head  = 0;
+        qint64 space = 0;
+
+        mutex.lock();
+
+        while((ringStop != true) && ((ringHead - ringTail) == ring.size()))
+        {
+            writable.wait(&mutex);
+        }
+
+        head  = ringHead;
+        space = ring.size() - (ringHead - ringTail);
+
+        if(ringStop == true)
+        {
+            mutex.unlock();
+
+            return;
+        }
+
+        mutex.unlock();
+
+        qint64 offset = head % ring.size();
+        qint64 length = qMin(qMin(space, ring.size() - offset), (qint64)(READ_AHEAD_CHUNK));
+        qint64 number = file->read(ring.data() + offset, length);
+
+        mutex.lock();
+
+        if(number > 0)
+        {
+            ringHead += number;
+        }
+        else
+        {
+            ringEnd = true;
+        }
+
+        readable.wakeOne();
+        mutex.unlock();
+
+        if(number <= 0)
+        {
+            return;
+        }
+    }
+}
+
+void YmodemFileSource::startReadAhead(qint64 offset)
+{
+    if(ring.size() != READ_AHEAD_SIZE)
+    {
+        ring.resize(READ_AHEAD_SIZE);
+    }
+
+    file->seek(offset);
+
+    ringHead = 0;
+    ringTail = 0;
+    ringStop = false;
+    ringEnd  = false;
+
+    start();
+}
+
+void YmodemFileSource::stopReadAhead()
+{
+    mutex.lock();
+
+    ringStop = true;
+
+    writable.wakeAll();
+    mutex.unlock();
+
+    wait();
+}
@@ -0,0 +1,79 @@
+/**
+  ******************************************************************************
+  * @file    YmodemFileSource.h
+  * @author  SerialPortYmodem contributors
+  * @version v1.0
+  * @date    16-October-2026
+  * @brief   Header file for YmodemFileSource.cpp module.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>Copyright &copy; 2026 SerialPortYmodem contributors</center></h2>
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#ifndef YMODEMFILESOURCE_H
+#define YMODEMFILESOURCE_H
+
+#include <QFile>
+#include <QMutex>
+#include <QThread>
+#include <QByteArray>
+#include <QWaitCondition>
+
+class YmodemFileSource : public QThread
+{
+    Q_OBJECT
+
+public:
+    explicit YmodemFileSource(QObject *parent = 0);
+    ~YmodemFileSource();
+
+    void setFileName(const QString &name);
+    QString fileName() const;
+
+    bool open();
+    void close();
+    bool isOpen() const;
+    bool isMapped() const;
+
+    qint64 size() const;
+    bool seek(qint64 offset);
+    qint64 read(char *data, qint64 maxSize);
+
+private:
+    void run();
+
+    void startReadAhead(qint64 offset);
+    void stopReadAhead();
+
+    QFile *file;
+    uchar *map;
+    qint64 fileSize;
+    qint64 position;
+
+    QMutex         mutex;
+    QWaitCondition readable;
+    QWaitCondition writable;
+    QByteArray     ring;
+    qint64         ringHead;
+    qint64         ringTail;
+    bool           ringStop;
+    bool           ringEnd;
+};
+
+#endif // YMODEMFILESOURCE_H
@@ -1,62 +1,147 @@
 #include "YmodemFileTransmit.h"
+#include <QDir>
+#include <QDateTime>
 #include <QFileInfo>
 
-#define READ_TIME_OUT   (10)
-#define WRITE_TIME_OUT  (100)
+#define WRITE_TIME_OUT      (100)
+#define STREAM_BUFFER_SIZE  (4 * (YMODEM_PACKET_1K_SIZE + YMODEM_PACKET_OVERHEAD))
+#define READ_BUFFER_SIZE    (64 * 1024)
 
 YmodemFileTransmit::YmodemFileTransmit(QObject *parent) :
     QObject(parent),
-    file(new QFile),
-    readTimer(new QTimer),
-    writeTimer(new QTimer),
-    serialPort(new QSerialPort)
+    file(new YmodemFileSource),
+    nextFile(new YmodemFileSource),
+    deadlineTimer(new QTimer(this)),
+    writeTimer(new QTimer(this)),
+    serialPort(new QSerialPort(this)),
+    portName("COM1"),
+    portBaudRate(115200)
 {
     setTimeDivide(499);
     setTimeMax(5);
     setErrorMax(999);
+    setOptions(OptionResume | OptionCompress | OptionDelta);
 
-    serialPort->setPortName("COM1");
-    serialPort->setBaudRate(115200);
     serialPort->setDataBits(QSerialPort::Data8);
     serialPort->setStopBits(QSerialPort::OneStop);
     serialPort->setParity(QSerialPort::NoParity);
     serialPort->setFlowControl(QSerialPort::NoFlowControl);
+    serialPort->setReadBufferSize(READ_BUFFER_SIZE);
 
-    connect(readTimer, SIGNAL(timeout()), this, SLOT(readTimeOut()));
+    deadlineTimer->setSingleShot(true);
+
+    connect(serialPort, SIGNAL(readyRead()), this, SLOT(readyRead()));
+    connect(serialPort, SIGNAL(bytesWritten(qint64)), this, SLOT(bytesWritten(qint64)));
+    connect(deadlineTimer, SIGNAL(timeout()), this, SLOT(deadlineTimeOut()));
     connect(writeTimer, SIGNAL(timeout()), this, SLOT(writeTimeOut()));
 }
 
 YmodemFileTransmit::~YmodemFileTransmit()
 {
     delete file;
-    delete readTimer;
+    delete nextFile;
+    delete deadlineTimer;
     delete writeTimer;
     delete serialPort;
 }
 
 void YmodemFileTransmit::setFileName(const QString &name)
 {
-    file->setFileName(name);
+    setFileNames(QStringList(name));
+}
+
+void YmodemFileTransmit::setFileNames(const QStringList &names)
+{
+    fileNames.clear();
+
+    foreach(const QString &name, names)
+    {
+        QFileInfo fileInfo(name);
+
+        if(fileInfo.isDir() == true)
+        {
+            foreach(const QFileInfo &entry, QDir(name).entryInfoList(QDir::Files, QDir::Name))
+            {
+                fileNames.append(entry.filePath());
+            }
+        }
+        else
+        {
+            fileNames.append(name);
+        }
+    }
+}
+
+void YmodemFileTransmit::setBaseFilePath(const QString &path)
+{
+    basePath = path.isEmpty() ? QString() : (path + "/");
 }
 
 void YmodemFileTransmit::setPortName(const QString &name)
 {
-    serialPort->setPortName(name);
+    portName = name;
 }
 
 void YmodemFileTransmit::setPortBaudRate(qint32 baudrate)
 {
-    serialPort->setBaudRate(baudrate);
+    portBaudRate = baudrate;
 }
 
 bool YmodemFileTransmit::startTransmit()
 {
-    progress = 0;
-    status   = StatusEstablish;
+    bool result = false;
+
+    cancel.storeRelease(0);
+
+    if(QThread::currentThread() == thread())
+    {
+        return openTransmit();
+    }
+
+    QMetaObject::invokeMethod(this, "openTransmit", Qt::BlockingQueuedConnection, Q_RETURN_ARG(bool, result));
+
+    return result;
+}
+
+void YmodemFileTransmit::stopTransmit()
+{
+    cancel.storeRelease(1);
+
+    QMetaObject::invokeMethod(this, "abortTransmit", Qt::QueuedConnection);
+}
+
+int YmodemFileTransmit::getTransmitProgress()
+{
+    return progress.loadAcquire();
+}
+
+Ymodem::Status YmodemFileTransmit::getTransmitStatus()
+{
+    return (Status)(status.loadAcquire());
+}
+
+quint64 YmodemFileTransmit::getTransmitBytes()
+{
+    return bytes.loadAcquire();
+}
+
+bool YmodemFileTransmit::openTransmit()
+{
+    progress.storeRelease(0);
+    status.storeRelease(StatusEstablish);
+    bytes.storeRelease(0);
+
+    fileIndex = 0;
+
+    file->close();
+    nextFile->close();
+
+    serialPort->setPortName(portName);
+    serialPort->setBaudRate(portBaudRate);
 
     if(serialPort->open(QSerialPort::ReadWrite) == true)
     {
-        readTimer->start(READ_TIME_OUT);
+        deadlineTimer->start(0);
 
         return true;
     }
@@ -66,33 +151,79 @@ bool YmodemFileTransmit::startTransmit()
     }
 }
 
-void YmodemFileTransmit::stopTransmit()
+void YmodemFileTransmit::abortTransmit()
 {
-    file->close();
-    abort();
-    status = StatusAbort;
-    writeTimer->start(WRITE_TIME_OUT);
+    if(isActive() == true)
+    {
+        file->close();
+        nextFile->close();
+        abort();
+        status.storeRelease(StatusAbort);
+        deadlineTimer->stop();
+        writeTimer->start(WRITE_TIME_OUT);
+    }
 }
 
-int YmodemFileTransmit::getTransmitProgress()
+bool YmodemFileTransmit::isActive()
 {
-    return progress;
+    return (status.loadAcquire() == StatusEstablish) || (status.loadAcquire() == StatusTransmit);
 }
 
-Ymodem::Status YmodemFileTransmit::getTransmitStatus()
+void YmodemFileTransmit::readyRead()
 {
-    return status;
+    while((serialPort->bytesAvailable() > 0) && (cancel.loadAcquire() == 0) && (isActive() == true))
+    {
+        transmit();
+    }
+
+    if(isActive() == true)
+    {
+        deadlineTimer->start(getTimeToDeadline());
+    }
+    else
+    {
+        deadlineTimer->stop();
+    }
 }
 
-void YmodemFileTransmit::readTimeOut()
+void YmodemFileTransmit::bytesWritten(qint64 bytes)
 {
-    readTimer->stop();
+    Q_UNUSED(bytes);
 
+    while(((getSessionOptions() & OptionStreaming) != 0) && (serialPort->bytesToWrite() < STREAM_BUFFER_SIZE) &&
+          (cancel.loadAcquire() == 0) && (isActive() == true))
+    {
+        qint64 pending = serialPort->bytesToWrite();
+
+        transmit();
+
+        if(serialPort->bytesToWrite() <= pending)
+        {
+            break;
+        }
+    }
+
+    if(isActive() == true)
+    {
+        deadlineTimer->start(getTimeToDeadline());
+    }
+    else
+    {
+        deadlineTimer->stop();
+    }
+}
+
+void YmodemFileTransmit::deadlineTimeOut()
+{
     transmit();
 
-    if((status == StatusEstablish) || (status == StatusTransmit))
+    if(isActive() == true)
     {
-        readTimer->start(READ_TIME_OUT);
+        deadlineTimer->start(getTimeToDeadline());
+    }
+    else
+    {
+        deadlineTimer->stop();
     }
 }
 
@@ -100,7 +231,8 @@ void YmodemFileTransmit::writeTimeOut()
 {
     writeTimer->stop();
     serialPort->close();
-    transmitStatus(status);
+    transmitStats(getTransferStats());
+    transmitStatus((Status)(status.loadAcquire()));
 }
 
 Ymodem::Code YmodemFileTransmit::callback(Status status, uint8_t *buff, uint32_t *len)
@@ -109,27 +241,76 @@ Ymodem::Code YmodemFileTransmit::callback(Status status, uint8_t *buff, uint32_t
     {
         case StatusEstablish:
         {
-            if(file->open(QFile::ReadOnly) == true)
+            file->close();
+
+            if((fileIndex >= fileNames.size()) && (fileIndex != 0))
+            {
+                nextFile->close();
+
+                return CodeEot;
+            }
+
+            if((fileIndex < fileNames.size()) && (nextFile->isOpen() == true) &&
+               (nextFile->fileName() == fileNames.at(fileIndex)))
             {
-                QFileInfo fileInfo(*file);
+                YmodemFileSource *temp = file;
 
-                fileSize  = fileInfo.size();
+                file     = nextFile;
+                nextFile = temp;
+            }
+            else if(fileIndex < fileNames.size())
+            {
+                nextFile->close();
+                file->setFileName(fileNames.at(fileIndex));
+                file->open();
+            }
+
+            if(file->isOpen() == true)
+            {
+                QFileInfo fileInfo(file->fileName());
+
+                fileSize  = file->size();
                 fileCount = 0;
 
+                compressEncoder.reset();
+
+                deltaStarted = false;
+
+                if(encoding() == OptionDelta)
+                {
+                    prepareDelta();
+                }
+
+                /* The modification time in octal follows the size, a resuming receiver checks it. */
+                QByteArray fileDesc = QByteArray::number(file->size()) + " " +
+                                      QByteArray::number((quint64)(fileInfo.lastModified().toMSecsSinceEpoch() / 1000), 8);
+
                 strcpy((char *)buff, fileInfo.fileName().toLocal8Bit().data());
-                strcpy((char *)buff + fileInfo.fileName().toLocal8Bit().size() + 1, QByteArray::number(fileInfo.size()).data());
+                strcpy((char *)buff + fileInfo.fileName().toLocal8Bit().size() + 1, fileDesc.data());
 
                 *len = YMODEM_PACKET_SIZE;
 
-                YmodemFileTransmit::status = StatusEstablish;
+                fileIndex++;
 
+                if(fileIndex < fileNames.size())
+                {
+                    nextFile->setFileName(fileNames.at(fileIndex));
+                    nextFile->open();
+                }
+
+                YmodemFileTransmit::status.storeRelease(StatusEstablish);
+                YmodemFileTransmit::progress.storeRelease(0);
+
+                transmitProgress(0);
                 transmitStatus(StatusEstablish);
 
                 return CodeAck;
             }
             else
             {
-                YmodemFileTransmit::status = StatusError;
+                nextFile->close();
+
+                YmodemFileTransmit::status.storeRelease(StatusError);
 
                 writeTimer->start(WRITE_TIME_OUT);
 
@@ -139,45 +320,146 @@ Ymodem::Code YmodemFileTransmit::callback(Status status, uint8_t *buff, uint32_t
 
         case StatusTransmit:
         {
-            if(fileSize != fileCount)
+            if(cancel.loadAcquire() != 0)
             {
-                if((fileSize - fileCount) > YMODEM_PACKET_SIZE)
+                file->close();
+                nextFile->close();
+
+                YmodemFileTransmit::status.storeRelease(StatusAbort);
+
+                writeTimer->start(WRITE_TIME_OUT);
+
+                return CodeCan;
+            }
+            else if((fileSize != fileCount) || (compressEncoder.available() > 0) || (deltaEncoder.available() > 0))
+            {
+                uint64_t count  = fileCount;
+                uint32_t mode   = encoding();
+                bool     result = true;
+
+                if((mode == OptionDelta) && (deltaStarted != true))
                 {
-                    fileCount += file->read((char *)buff, YMODEM_PACKET_1K_SIZE);
+                    deltaEncoder.reset(deltaCrc);
+
+                    deltaStarted = true;
+                }
 
-                    *len = YMODEM_PACKET_1K_SIZE;
+                while((mode != OptionNone) && (result == true) && (fileSize != fileCount) &&
+                      ((uint32_t)((mode == OptionDelta) ? deltaEncoder.available() : compressEncoder.available()) < *len))
+                {
+                    chunk.resize((int)(qMin<uint64_t>(fileSize - fileCount, COMPRESS_CHUNK_SIZE)));
+
+                    result     = file->read(chunk.data(), chunk.size()) == chunk.size();
+                    fileCount += chunk.size();
+
+                    if(mode == OptionDelta)
+                    {
+                        deltaEncoder.encode(chunk.constData(), chunk.size(), fileCount == fileSize);
+                    }
+                    else
+                    {
+                        compressEncoder.encode(chunk.constData(), chunk.size());
+                    }
+                }
+
+                uint64_t remain = (mode == OptionDelta)    ? (uint64_t)(deltaEncoder.available())    :
+                                  (mode == OptionCompress) ? (uint64_t)(compressEncoder.available()) : (fileSize - fileCount);
+
+                if(remain < *len)
+                {
+                    *len = ((remain > YMODEM_PACKET_SIZE) && (*len >= YMODEM_PACKET_1K_SIZE)) ? YMODEM_PACKET_1K_SIZE : YMODEM_PACKET_SIZE;
+                }
+
+                if(mode == OptionDelta)
+                {
+                    deltaEncoder.take((char *)buff, *len);
+                }
+                else if(mode == OptionCompress)
+                {
+                    compressEncoder.take((char *)buff, *len);
                 }
                 else
                 {
-                    fileCount += file->read((char *)buff, YMODEM_PACKET_SIZE);
+                    fileCount += file->read((char *)buff, *len);
+                    result     = fileCount == qMin<uint64_t>(fileSize, count + *len);
+                }
+
+                if(result != true)
+                {
+                    file->close();
+                    nextFile->close();
+
+                    YmodemFileTransmit::status.storeRelease(StatusError);
+
+                    writeTimer->start(WRITE_TIME_OUT);
 
-                    *len = YMODEM_PACKET_SIZE;
+                    return CodeCan;
                 }
 
-                progress = (int)(fileCount * 100 / fileSize);
+                YmodemFileTransmit::bytes.fetchAndAddRelease(fileCount - count);
 
-                YmodemFileTransmit::status = StatusTransmit;
+                int value = (int)(fileCount * 100 / fileSize);
 
-                transmitProgress(progress);
-                transmitStatus(StatusTransmit);
+                if(YmodemFileTransmit::progress.fetchAndStoreRelease(value) != value)
+                {
+                    transmitProgress(value);
+                }
+
+                if(YmodemFileTransmit::status.fetchAndStoreRelease(StatusTransmit) != StatusTransmit)
+                {
+                    transmitStatus(StatusTransmit);
+                }
 
                 return CodeAck;
             }
             else
             {
-                YmodemFileTransmit::status = StatusTransmit;
-
-                transmitStatus(StatusTransmit);
+                if(YmodemFileTransmit::status.fetchAndStoreRelease(StatusTransmit) != StatusTransmit)
+                {
+                    transmitStatus(StatusTransmit);
+                }
 
                 return CodeEot;
             }
         }
 
+        case StatusResume:
+        {
+            uint64_t offset = 0;
+
+            for(uint32_t i = 0; i < YMODEM_RESUME_SIZE; i++)
+            {
+                offset = (offset << 8) | buff[i];
+            }
+
+            if((offset <= fileSize) && (file->seek(offset) == true))
+            {
+                int value = (fileSize != 0) ? (int)(offset * 100 / fileSize) : 0;
+
+                fileCount = offset;
+
+                compressEncoder.reset();
+
+                deltaStarted = false;
+
+                YmodemFileTransmit::progress.storeRelease(value);
+
+                transmitProgress(value);
+
+                return CodeAck;
+            }
+            else
+            {
+                return CodeCan;
+            }
+        }
+
         case StatusFinish:
         {
             file->close();
+            nextFile->close();
 
-            YmodemFileTransmit::status = StatusFinish;
+            YmodemFileTransmit::status.storeRelease(StatusFinish);
 
             writeTimer->start(WRITE_TIME_OUT);
 
@@ -187,8 +469,9 @@ Ymodem::Code YmodemFileTransmit::callback(Status status, uint8_t *buff, uint32_t
         case StatusAbort:
         {
             file->close();
+            nextFile->close();
 
-            YmodemFileTransmit::status = StatusAbort;
+            YmodemFileTransmit::status.storeRelease(StatusAbort);
 
             writeTimer->start(WRITE_TIME_OUT);
 
@@ -197,7 +480,7 @@ Ymodem::Code YmodemFileTransmit::callback(Status status, uint8_t *buff, uint32_t
 
         case StatusTimeout:
         {
-            YmodemFileTransmit::status = StatusTimeout;
+            YmodemFileTransmit::status.storeRelease(StatusTimeout);
 
             writeTimer->start(WRITE_TIME_OUT);
 
@@ -207,8 +490,9 @@ Ymodem::Code YmodemFileTransmit::callback(Status status, uint8_t *buff, uint32_t
         default:
         {
             file->close();
+            nextFile->close();
 
-            YmodemFileTransmit::status = StatusError;
+            YmodemFileTransmit::status.storeRelease(StatusError);
 
             writeTimer->start(WRITE_TIME_OUT);
 
@@ -217,6 +501,43 @@ Ymodem::Code YmodemFileTransmit::callback(Status status, uint8_t *buff, uint32_t
     }
 }
 
+uint32_t YmodemFileTransmit::encoding()
+{
+    uint32_t session = getSessionOptions();
+
+    /* A delta already compresses its literals. */
+    return ((session & OptionDelta) != 0) ? OptionDelta : (session & OptionCompress);
+}
+
+void YmodemFileTransmit::prepareDelta()
+{
+    QString name = basePath.isEmpty() ? QString() : (basePath + QFileInfo(file->fileName()).fileName());
+    QFile   source(file->fileName());
+    bool    valid = (deltaEncoder.setBase(name) == true) && (deltaEncoder.hasBase() == true) &&
+                    (source.open(QFile::ReadOnly) == true);
+
+    /* The delta header carries the CRC32 of the whole file, so the file is read once here, in the
+     * worker before its header packet is sent. Only the base of the current file is held. */
+    deltaCrc = 0;
+
+    while((valid == true) && (source.atEnd() != true))
+    {
+        QByteArray data = source.read(READ_BUFFER_SIZE);
+
+        valid    = data.isEmpty() != true;
+        deltaCrc = crc32Slice8(deltaCrc, (const uint8_t *)data.constData(), data.size());
+    }
+
+    /* Without a base, or when the file can not be read ahead, the file goes as compressed
+     * literals behind a header without a base, which any receiver accepts. */
+    if(valid != true)
+    {
+        deltaEncoder.setBase(QString());
+
+        deltaCrc = 0;
+    }
+}
+
 uint32_t YmodemFileTransmit::read(uint8_t *buff, uint32_t len)
 {
     return serialPort->read((char *)buff, len);
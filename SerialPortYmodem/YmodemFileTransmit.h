@@ -1,11 +1,16 @@
 #ifndef YMODEMFILETRANSMIT_H
 #define YMODEMFILETRANSMIT_H
 
-#include <QFile>
 #include <QTimer>
+#include <QThread>
+#include <QAtomicInt>
+#include <QStringList>
 #include <QObject>
 #include <QSerialPort>
 #include "Ymodem.h"
+#include "YmodemFileSource.h"
+#include "YmodemCompress.h"
+#include "YmodemDelta.h"
 
 class YmodemFileTransmit : public QObject, public Ymodem
 {
@@ -16,6 +21,8 @@ public:
     ~YmodemFileTransmit();
 
     void setFileName(const QString &name);
+    void setFileNames(const QStringList &names);
+    void setBaseFilePath(const QString &path);
 
     void setPortName(const QString &name);
     void setPortBaudRate(qint32 baudrate);
@@ -25,30 +32,57 @@ public:
 
     int getTransmitProgress();
     Status getTransmitStatus();
+    quint64 getTransmitBytes();
 
 signals:
     void transmitProgress(int progress);
     void transmitStatus(YmodemFileTransmit::Status status);
+    void transmitStats(YmodemFileTransmit::Stats stats);
 
 private slots:
-    void readTimeOut();
+    void readyRead();
+    void bytesWritten(qint64 bytes);
+    void deadlineTimeOut();
     void writeTimeOut();
 
+    bool openTransmit();
+    void abortTransmit();
+
 private:
+    bool isActive();
+
     Code callback(Status status, uint8_t *buff, uint32_t *len);
 
+    uint32_t encoding();
+    void prepareDelta();
+
     uint32_t read(uint8_t *buff, uint32_t len);
     uint32_t write(uint8_t *buff, uint32_t len);
 
-    QFile       *file;
-    QTimer      *readTimer;
-    QTimer      *writeTimer;
-    QSerialPort *serialPort;
+    YmodemFileSource *file;
+    YmodemFileSource *nextFile;
+    QTimer           *deadlineTimer;
+    QTimer           *writeTimer;
+    QSerialPort      *serialPort;
+
+    QString     portName;
+    qint32      portBaudRate;
+    QAtomicInt  progress;
+    QAtomicInt  status;
+    QAtomicInt  cancel;
+
+    QAtomicInteger<quint64> bytes;
+    QStringList fileNames;
+    QString     basePath;
+    int         fileIndex;
+    uint64_t    fileSize;
+    uint64_t    fileCount;
 
-    int      progress;
-    Status   status;
-    uint64_t fileSize;
-    uint64_t fileCount;
+    YmodemCompressEncoder compressEncoder;
+    YmodemDeltaEncoder    deltaEncoder;
+    quint32               deltaCrc;
+    bool                  deltaStarted;
+    QByteArray            chunk;
 };
 
 #endif // YMODEMFILETRANSMIT_H
@@ -0,0 +1,884 @@
+/**
+  ******************************************************************************
+  * @file    YmodemReactor.cpp
+  * @author  SerialPortYmodem contributors
+  * @version v1.0
+  * @date    16-October-2026
+  * @brief   Ymodem epoll reactor module source file.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>Copyright &copy; 2026 SerialPortYmodem contributors</center></h2>
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+/* Header includes -----------------------------------------------------------*/
+#include "YmodemReactor.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+/* Macro definitions ---------------------------------------------------------*/
+#define YMODEM_REACTOR_DRAIN_TIME   (100)
+
+/* Type definitions ----------------------------------------------------------*/
+/* Variable declarations -----------------------------------------------------*/
+/* Variable definitions ------------------------------------------------------*/
+/* Function declarations -----------------------------------------------------*/
+/* Function definitions ------------------------------------------------------*/
+
+/**
+  * @brief  Ymodem reactor session constructor.
+  * @param  [in] fd:        The file descriptor of the port, switched to non-blocking mode.
+  * @param  [in] direction: Transmit or receive.
+  * @return None.
+  */
+YmodemReactorSession::YmodemReactorSession(int fd, Direction direction)
+{
+  this->fd        = fd;
+  this->direction = direction;
+  finished        = false;
+  status          = StatusEstablish;
+  inputHead       = 0;
+  inputTail       = 0;
+  outputTail      = 0;
+  timerPrev       = NULL;
+  timerNext       = NULL;
+  timerExpiry     = 0;
+  timerArmed      = false;
+  writeArmed      = false;
+  attached        = false;
+  broken          = false;
+
+  memset(&stats, 0, sizeof(stats));
+
+  input.resize(YMODEM_REACTOR_INPUT_SIZE);
+
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+}
+
+/**
+  * @brief  Ymodem reactor session destructor.
+  * @note   The file descriptor is owned by the caller and is not closed.
+  * @param  None.
+  * @return None.
+  */
+YmodemReactorSession::~YmodemReactorSession()
+{
+}
+
+/**
+  * @brief  Get the file descriptor of the port.
+  * @param  None.
+  * @return The file descriptor.
+  */
+int YmodemReactorSession::getFd()
+{
+  return fd;
+}
+
+/**
+  * @brief  Get the direction of the session.
+  * @param  None.
+  * @return Transmit or receive.
+  */
+YmodemReactorSession::Direction YmodemReactorSession::getDirection()
+{
+  return direction;
+}
+
+/**
+  * @brief  Whether the session has finished.
+  * @param  None.
+  * @return The session has finished.
+  */
+bool YmodemReactorSession::isFinished()
+{
+  return finished;
+}
+
+/**
+  * @brief  Get the last status of the session.
+  * @param  None.
+  * @return The last status reported to the callback.
+  */
+Ymodem::Status YmodemReactorSession::getStatus()
+{
+  return status;
+}
+
+/**
+  * @brief  Get the session statistics.
+  * @param  None.
+  * @return The wakeups, latency and CPU time in nanoseconds and bytes of the session.
+  */
+const YmodemReactorStats &YmodemReactorSession::getStats()
+{
+  return stats;
+}
+
+/**
+  * @brief  Open a serial port in raw non-blocking mode.
+  * @param  [in] name:     The device name of the port.
+  * @param  [in] baudrate: The baud rate, ignored when it is not a standard rate.
+  * @return The file descriptor or -1.
+  */
+int YmodemReactorSession::openPort(const char *name, uint32_t baudrate)
+{
+  static const struct
+  {
+    uint32_t baudrate;
+    speed_t  speed;
+  } speeds[] =
+  {
+    {1200,    B1200},
+    {2400,    B2400},
+    {4800,    B4800},
+    {9600,    B9600},
+    {19200,   B19200},
+    {38400,   B38400},
+    {57600,   B57600},
+    {115200,  B115200},
+    {230400,  B230400},
+    {460800,  B460800},
+    {921600,  B921600}
+  };
+
+  struct termios tio;
+
+  int fd = open(name, O_RDWR | O_NOCTTY | O_NONBLOCK);
+
+  if(fd < 0)
+  {
+    return -1;
+  }
+
+  if(tcgetattr(fd, &tio) != 0)
+  {
+    close(fd);
+
+    return -1;
+  }
+
+  cfmakeraw(&tio);
+
+  for(uint32_t i = 0; i < sizeof(speeds) / sizeof(speeds[0]); i++)
+  {
+    if(speeds[i].baudrate == baudrate)
+    {
+      cfsetispeed(&tio, speeds[i].speed);
+      cfsetospeed(&tio, speeds[i].speed);
+    }
+  }
+
+  if(tcsetattr(fd, TCSANOW, &tio) != 0)
+  {
+    close(fd);
+
+    return -1;
+  }
+
+  return fd;
+}
+
+/**
+  * @brief  Forward the ymodem callback to the session and track its status.
+  * @note   A cancelled establish or transmit step ends the session with StatusError.
+  * @param  [in]     status: The status of the ymodem.
+  * @param  [in/out] buff:   The buffer of the packet.
+  * @param  [in/out] len:    The length of the packet.
+  * @return The code returned by the session.
+  */
+Ymodem::Code YmodemReactorSession::callback(Status status, uint8_t *buff, uint32_t *len)
+{
+  Code code = sessionCallback(status, buff, len);
+
+  switch(status)
+  {
+    case StatusEstablish:
+    case StatusTransmit:
+    {
+      if(code == CodeCan)
+      {
+        YmodemReactorSession::status = StatusError;
+        finished                     = true;
+      }
+      else
+      {
+        YmodemReactorSession::status = status;
+      }
+
+      break;
+    }
+
+    case StatusResume:
+    {
+      break;
+    }
+
+    default:
+    {
+      YmodemReactorSession::status = status;
+      finished                     = true;
+    }
+  }
+
+  return code;
+}
+
+/**
+  * @brief  Read the bytes received by the reactor.
+  * @param  [out] buff: The buffer to read into.
+  * @param  [in]  len:  The maximum length to read.
+  * @return The length read.
+  */
+uint32_t YmodemReactorSession::read(uint8_t *buff, uint32_t len)
+{
+  uint32_t size = available() < len ? available() : len;
+
+  memcpy(buff, input.data() + inputTail, size);
+
+  inputTail += size;
+
+  return size;
+}
+
+/**
+  * @brief  Queue bytes for the reactor to write.
+  * @param  [in] buff: The buffer to write.
+  * @param  [in] len:  The length to write.
+  * @return The length queued.
+  */
+uint32_t YmodemReactorSession::write(uint8_t *buff, uint32_t len)
+{
+  output.insert(output.end(), buff, buff + len);
+
+  return len;
+}
+
+/**
+  * @brief  Get the length of the received bytes not read yet.
+  * @param  None.
+  * @return The length available.
+  */
+uint32_t YmodemReactorSession::available()
+{
+  return inputHead - inputTail;
+}
+
+/**
+  * @brief  Get the length of the queued bytes not written yet.
+  * @param  None.
+  * @return The length pending.
+  */
+uint32_t YmodemReactorSession::pending()
+{
+  return output.size() - outputTail;
+}
+
+/**
+  * @brief  Read from the port into the input buffer.
+  * @note   End of file or an error other than EAGAIN marks the port broken.
+  * @param  None.
+  * @return Any bytes were read.
+  */
+bool YmodemReactorSession::fill()
+{
+  if(inputTail == inputHead)
+  {
+    inputHead = 0;
+    inputTail = 0;
+  }
+  else if(inputTail != 0)
+  {
+    memmove(input.data(), input.data() + inputTail, inputHead - inputTail);
+
+    inputHead -= inputTail;
+    inputTail  = 0;
+  }
+
+  ssize_t number = ::read(fd, input.data() + inputHead, input.size() - inputHead);
+
+  if(number > 0)
+  {
+    inputHead       += number;
+    stats.bytesRead += number;
+
+    return true;
+  }
+  else
+  {
+    if((number == 0) || ((errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR)))
+    {
+      broken = true;
+    }
+
+    return false;
+  }
+}
+
+/**
+  * @brief  Write the queued bytes to the port.
+  * @param  None.
+  * @return The length written.
+  */
+uint32_t YmodemReactorSession::flush()
+{
+  uint32_t count = 0;
+
+  while(pending() > 0)
+  {
+    ssize_t number = ::write(fd, output.data() + outputTail, pending());
+
+    if(number <= 0)
+    {
+      break;
+    }
+
+    count      += number;
+    outputTail += number;
+  }
+
+  if(pending() == 0)
+  {
+    output.clear();
+
+    outputTail = 0;
+  }
+
+  stats.bytesWritten += count;
+
+  return count;
+}
+
+/**
+  * @brief  Run the ymodem state machine once.
+  * @param  None.
+  * @return None.
+  */
+void YmodemReactorSession::step()
+{
+  if(direction == DirectionTransmit)
+  {
+    transmit();
+  }
+  else
+  {
+    receive();
+  }
+}
+
+/**
+  * @brief  End the session on a broken port.
+  * @note   The state machine is reset and the session finishes with StatusError.
+  * @param  None.
+  * @return None.
+  */
+void YmodemReactorSession::hangup()
+{
+  abort();
+
+  callback(StatusError, NULL, NULL);
+}
+
+/**
+  * @brief  Ymodem reactor constructor.
+  * @param  [in] tickTime: The time of one timer wheel slot in milliseconds.
+  * @return None.
+  */
+YmodemReactor::YmodemReactor(uint32_t tickTime)
+{
+  this->tickTime = tickTime > 0 ? tickTime : 1;
+  tickLast       = 0;
+  timerCount     = 0;
+  epoll          = epoll_create1(EPOLL_CLOEXEC);
+  wake           = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  count          = 0;
+  idleTime       = 0;
+
+  memset(&stats, 0, sizeof(stats));
+
+  wheel.resize(YMODEM_REACTOR_WHEEL_SIZE, NULL);
+
+  tickLast = tickNow();
+
+  struct epoll_event event;
+
+  event.events   = EPOLLIN;
+  event.data.ptr = NULL;
+
+  epoll_ctl(epoll, EPOLL_CTL_ADD, wake, &event);
+}
+
+/**
+  * @brief  Ymodem reactor destructor.
+  * @param  None.
+  * @return None.
+  */
+YmodemReactor::~YmodemReactor()
+{
+  for(uint32_t i = 0; i < wheel.size(); i++)
+  {
+    while(wheel[i] != NULL)
+    {
+      remove(wheel[i]);
+    }
+  }
+
+  close(epoll);
+  close(wake);
+}
+
+/**
+  * @brief  Add a session to the reactor and start it on the next loop.
+  * @param  [in] session: The session to add.
+  * @return Success or failure.
+  */
+bool YmodemReactor::add(YmodemReactorSession *session)
+{
+  struct epoll_event event;
+
+  event.events   = EPOLLIN;
+  event.data.ptr = session;
+
+  if((session->attached == true) || (epoll_ctl(epoll, EPOLL_CTL_ADD, session->fd, &event) != 0))
+  {
+    return false;
+  }
+
+  session->attached   = true;
+  session->writeArmed = false;
+
+  timerArm(session, 0);
+
+  count++;
+
+  return true;
+}
+
+/**
+  * @brief  Remove a session from the reactor.
+  * @param  [in] session: The session to remove.
+  * @return None.
+  */
+void YmodemReactor::remove(YmodemReactorSession *session)
+{
+  if(session->attached == true)
+  {
+    epoll_ctl(epoll, EPOLL_CTL_DEL, session->fd, NULL);
+    timerCancel(session);
+
+    session->attached = false;
+
+    count--;
+  }
+}
+
+/**
+  * @brief  Run the reactor until every session has finished or it is stopped.
+  * @note   Only the sessions whose ports are ready or whose deadlines expired are woken.
+  * @param  None.
+  * @return Success or failure.
+  */
+bool YmodemReactor::run()
+{
+  struct epoll_event                  events[YMODEM_REACTOR_EVENT_SIZE];
+  std::vector<YmodemReactorSession *> expired;
+
+  while(count > 0)
+  {
+    uint64_t cpu    = clock(CLOCK_THREAD_CPUTIME_ID);
+    uint64_t before = clock(CLOCK_MONOTONIC);
+    int      number = epoll_wait(epoll, events, YMODEM_REACTOR_EVENT_SIZE, timerWait());
+    uint64_t ready  = clock(CLOCK_MONOTONIC);
+
+    idleTime += ready - before;
+
+    if((number < 0) && (errno != EINTR))
+    {
+      return false;
+    }
+
+    for(int i = 0; i < number; i++)
+    {
+      YmodemReactorSession *session = (YmodemReactorSession *)(events[i].data.ptr);
+
+      if(session == NULL)
+      {
+        uint64_t value = 0;
+
+        if(::read(wake, &value, sizeof(value)) == sizeof(value))
+        {
+          stats.cpuTime += clock(CLOCK_THREAD_CPUTIME_ID) - cpu;
+
+          return true;
+        }
+
+        continue;
+      }
+
+      if(session->attached == true)
+      {
+        if((events[i].events & (EPOLLERR | EPOLLHUP)) != 0)
+        {
+          session->broken = true;
+        }
+
+        service(session, ready, false, (events[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP)) != 0);
+      }
+    }
+
+    timerExpire(expired);
+
+    for(uint32_t i = 0; i < expired.size(); i++)
+    {
+      uint64_t due = expired[i]->timerExpiry * tickTime * 1000000ULL;
+
+      stats.timeouts++;
+      expired[i]->stats.timeouts++;
+
+      service(expired[i], due < ready ? due : ready, true, false);
+    }
+
+    stats.cpuTime += clock(CLOCK_THREAD_CPUTIME_ID) - cpu;
+  }
+
+  return true;
+}
+
+/**
+  * @brief  Stop the reactor from another thread.
+  * @param  None.
+  * @return None.
+  */
+void YmodemReactor::stop()
+{
+  uint64_t value = 1;
+
+  if(::write(wake, &value, sizeof(value)) != sizeof(value))
+  {
+    return;
+  }
+}
+
+/**
+  * @brief  Get the number of sessions in the reactor.
+  * @param  None.
+  * @return The number of sessions.
+  */
+uint32_t YmodemReactor::getCount()
+{
+  return count;
+}
+
+/**
+  * @brief  Get the aggregate statistics of the reactor.
+  * @param  None.
+  * @return The wakeups, latency and CPU time in nanoseconds and bytes of all sessions.
+  */
+const YmodemReactorStats &YmodemReactor::getStats()
+{
+  return stats;
+}
+
+/**
+  * @brief  Get the time the reactor waited for events.
+  * @param  None.
+  * @return The idle time in nanoseconds.
+  */
+uint64_t YmodemReactor::getIdleTime()
+{
+  return idleTime;
+}
+
+/**
+  * @brief  Service a woken session.
+  * @note   The session is stepped while input is available, and a transmitter in
+  *         streaming mode keeps queueing packets while the port accepts them. A
+  *         finished session is removed once its output has drained. A session whose
+  *         port hung up, failed or reached end of file is ended with StatusError and
+  *         removed at once.
+  * @param  [in] session:   The session to service.
+  * @param  [in] reference: The time the wakeup became due in nanoseconds.
+  * @param  [in] timer:     The session was woken by its deadline.
+  * @param  [in] readable:  The port of the session is readable.
+  * @return None.
+  */
+void YmodemReactor::service(YmodemReactorSession *session, uint64_t reference, bool timer, bool readable)
+{
+  uint64_t cpu     = clock(CLOCK_THREAD_CPUTIME_ID);
+  uint64_t read    = session->stats.bytesRead;
+  uint64_t written = session->stats.bytesWritten;
+
+  timerCancel(session);
+
+  if(readable == true)
+  {
+    session->fill();
+  }
+
+  if((timer == true) && (session->finished != true))
+  {
+    session->step();
+  }
+
+  while((session->available() > 0) && (session->finished != true))
+  {
+    session->step();
+  }
+
+  /* A broken port cannot take the queued bytes, the cancel codes of the reset included. */
+  if(session->broken == true)
+  {
+    if(session->finished != true)
+    {
+      session->hangup();
+    }
+
+    session->output.clear();
+    session->outputTail = 0;
+  }
+
+  while((session->flush() > 0) && (session->direction == YmodemReactorSession::DirectionTransmit) &&
+        ((session->getSessionOptions() & Ymodem::OptionStreaming) != 0))
+  {
+    while((session->finished != true) && (session->pending() < YMODEM_REACTOR_STREAM_SIZE))
+    {
+      uint32_t pending = session->pending();
+
+      session->step();
+
+      if(session->pending() <= pending)
+      {
+        break;
+      }
+    }
+  }
+
+  writeArm(session, session->pending() > 0);
+
+  if(session->finished != true)
+  {
+    timerArm(session, session->getTimeToDeadline());
+  }
+  else if((session->pending() > 0) && (timer != true))
+  {
+    timerArm(session, YMODEM_REACTOR_DRAIN_TIME);
+  }
+  else
+  {
+    remove(session);
+  }
+
+  uint64_t now     = clock(CLOCK_MONOTONIC);
+  uint64_t latency = now > reference ? now - reference : 0;
+
+  session->stats.wakeups++;
+  session->stats.latencyTotal += latency;
+  session->stats.latencyMax    = latency > session->stats.latencyMax ? latency : session->stats.latencyMax;
+  session->stats.cpuTime      += clock(CLOCK_THREAD_CPUTIME_ID) - cpu;
+
+  stats.wakeups++;
+  stats.latencyTotal += latency;
+  stats.latencyMax    = latency > stats.latencyMax ? latency : stats.latencyMax;
+  stats.bytesRead    += session->stats.bytesRead - read;
+  stats.bytesWritten += session->stats.bytesWritten - written;
+}
+
+/**
+  * @brief  Arm the deadline of a session in the timer wheel.
+  * @param  [in] session: The session to arm.
+  * @param  [in] delay:   The delay in milliseconds.
+  * @return None.
+  */
+void YmodemReactor::timerArm(YmodemReactorSession *session, uint32_t delay)
+{
+  timerCancel(session);
+
+  uint64_t expiry = tickNow() + (delay + tickTime - 1) / tickTime;
+
+  /* Slots up to tickLast have been expired already. */
+  if(expiry <= tickLast)
+  {
+    expiry = tickLast + 1;
+  }
+
+  YmodemReactorSession **slot = &(wheel[expiry % wheel.size()]);
+
+  session->timerExpiry = expiry;
+  session->timerArmed  = true;
+  session->timerPrev   = NULL;
+  session->timerNext   = *slot;
+
+  if(*slot != NULL)
+  {
+    (*slot)->timerPrev = session;
+  }
+
+  *slot = session;
+
+  timerCount++;
+}
+
+/**
+  * @brief  Cancel the deadline of a session.
+  * @param  [in] session: The session to cancel.
+  * @return None.
+  */
+void YmodemReactor::timerCancel(YmodemReactorSession *session)
+{
+  if(session->timerArmed != true)
+  {
+    return;
+  }
+
+  if(session->timerPrev != NULL)
+  {
+    session->timerPrev->timerNext = session->timerNext;
+  }
+  else
+  {
+    wheel[session->timerExpiry % wheel.size()] = session->timerNext;
+  }
+
+  if(session->timerNext != NULL)
+  {
+    session->timerNext->timerPrev = session->timerPrev;
+  }
+
+  session->timerPrev  = NULL;
+  session->timerNext  = NULL;
+  session->timerArmed = false;
+
+  timerCount--;
+}
+
+/**
+  * @brief  Get the time until the next occupied slot of the timer wheel.
+  * @param  None.
+  * @return The epoll timeout in milliseconds, -1 when no deadline is armed.
+  */
+int YmodemReactor::timerWait()
+{
+  if(timerCount == 0)
+  {
+    return -1;
+  }
+
+  uint64_t now = tickNow();
+
+  for(uint64_t tick = tickLast + 1; tick <= tickLast + wheel.size(); tick++)
+  {
+    if(wheel[tick % wheel.size()] != NULL)
+    {
+      return tick > now ? (int)((tick - now) * tickTime) : 0;
+    }
+  }
+
+  return (int)(wheel.size() * tickTime);
+}
+
+/**
+  * @brief  Collect the sessions whose deadlines expired.
+  * @note   A slot holds the deadlines of later rounds of the wheel too; only the due
+  *         ones are taken out.
+  * @param  [out] expired: The expired sessions.
+  * @return None.
+  */
+void YmodemReactor::timerExpire(std::vector<YmodemReactorSession *> &expired)
+{
+  uint64_t now   = tickNow();
+  uint64_t first = tickLast + 1;
+
+  expired.clear();
+
+  if(now - tickLast > wheel.size())
+  {
+    first = now - wheel.size() + 1;
+  }
+
+  for(uint64_t tick = first; tick <= now; tick++)
+  {
+    YmodemReactorSession *session = wheel[tick % wheel.size()];
+
+    while(session != NULL)
+    {
+      YmodemReactorSession *next = session->timerNext;
+
+      if(session->timerExpiry <= now)
+      {
+        timerCancel(session);
+
+        expired.push_back(session);
+      }
+
+      session = next;
+    }
+  }
+
+  tickLast = now > tickLast ? now : tickLast;
+}
+
+/**
+  * @brief  Watch a session for writability while it has queued output.
+  * @param  [in] session: The session to watch.
+  * @param  [in] arm:     Watch or stop watching.
+  * @return None.
+  */
+void YmodemReactor::writeArm(YmodemReactorSession *session, bool arm)
+{
+  if(session->writeArmed != arm)
+  {
+    struct epoll_event event;
+
+    event.events   = arm == true ? (EPOLLIN | EPOLLOUT) : EPOLLIN;
+    event.data.ptr = session;
+
+    epoll_ctl(epoll, EPOLL_CTL_MOD, session->fd, &event);
+
+    session->writeArmed = arm;
+  }
+}
+
+/**
+  * @brief  Get the current timer wheel tick.
+  * @param  None.
+  * @return The tick.
+  */
+uint64_t YmodemReactor::tickNow()
+{
+  return clock(CLOCK_MONOTONIC) / 1000000ULL / tickTime;
+}
+
+/**
+  * @brief  Read a clock.
+  * @param  [in] id: The clock to read.
+  * @return The time in nanoseconds.
+  */
+uint64_t YmodemReactor::clock(int id)
+{
+  struct timespec time;
+
+  clock_gettime(id, &time);
+
+  return (uint64_t)(time.tv_sec) * 1000000000ULL + time.tv_nsec;
+}
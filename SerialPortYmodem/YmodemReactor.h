@@ -0,0 +1,166 @@
+/**
+  ******************************************************************************
+  * @file    YmodemReactor.h
+  * @author  SerialPortYmodem contributors
+  * @version v1.0
+  * @date    16-October-2026
+  * @brief   Header file for YmodemReactor.cpp module.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>Copyright &copy; 2026 SerialPortYmodem contributors</center></h2>
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#ifndef __YMODEM_REACTOR_H
+#define __YMODEM_REACTOR_H
+
+/* Header includes -----------------------------------------------------------*/
+#include <stdint.h>
+#include <vector>
+#include "Ymodem.h"
+
+/* Macro definitions ---------------------------------------------------------*/
+#define YMODEM_REACTOR_WHEEL_SIZE   (1024)
+#define YMODEM_REACTOR_EVENT_SIZE   (256)
+#define YMODEM_REACTOR_INPUT_SIZE   (64 * 1024)
+#define YMODEM_REACTOR_STREAM_SIZE  (4 * (YMODEM_PACKET_1K_SIZE + YMODEM_PACKET_OVERHEAD))
+
+/* Type definitions ----------------------------------------------------------*/
+struct YmodemReactorStats
+{
+  uint64_t wakeups;
+  uint64_t timeouts;
+  uint64_t latencyTotal;
+  uint64_t latencyMax;
+  uint64_t cpuTime;
+  uint64_t bytesRead;
+  uint64_t bytesWritten;
+};
+
+class YmodemReactor;
+
+class YmodemReactorSession : public Ymodem
+{
+public:
+  enum Direction
+  {
+    DirectionTransmit,
+    DirectionReceive
+  };
+
+  YmodemReactorSession(int fd, Direction direction);
+  virtual ~YmodemReactorSession();
+
+  int getFd();
+  Direction getDirection();
+
+  bool isFinished();
+  Status getStatus();
+
+  const YmodemReactorStats &getStats();
+
+  static int openPort(const char *name, uint32_t baudrate);
+
+protected:
+  virtual Code sessionCallback(Status status, uint8_t *buff, uint32_t *len) = 0;
+
+private:
+  friend class YmodemReactor;
+
+  Code callback(Status status, uint8_t *buff, uint32_t *len);
+
+  uint32_t read(uint8_t *buff, uint32_t len);
+  uint32_t write(uint8_t *buff, uint32_t len);
+
+  uint32_t available();
+  uint32_t pending();
+  bool fill();
+  uint32_t flush();
+  void step();
+  void hangup();
+
+  int       fd;
+  Direction direction;
+  bool      finished;
+  Status    status;
+
+  std::vector<uint8_t> input;
+  std::vector<uint8_t> output;
+  uint32_t             inputHead;
+  uint32_t             inputTail;
+  uint32_t             outputTail;
+
+  YmodemReactorStats stats;
+
+  YmodemReactorSession *timerPrev;
+  YmodemReactorSession *timerNext;
+  uint64_t              timerExpiry;
+  bool                  timerArmed;
+  bool                  writeArmed;
+  bool                  attached;
+  bool                  broken;
+};
+
+class YmodemReactor
+{
+public:
+  YmodemReactor(uint32_t tickTime = 1);
+  ~YmodemReactor();
+
+  bool add(YmodemReactorSession *session);
+  void remove(YmodemReactorSession *session);
+
+  bool run();
+  void stop();
+
+  uint32_t getCount();
+  const YmodemReactorStats &getStats();
+  uint64_t getIdleTime();
+
+private:
+  void service(YmodemReactorSession *session, uint64_t reference, bool timer, bool readable);
+
+  void timerArm(YmodemReactorSession *session, uint32_t delay);
+  void timerCancel(YmodemReactorSession *session);
+  int timerWait();
+  void timerExpire(std::vector<YmodemReactorSession *> &expired);
+
+  void writeArm(YmodemReactorSession *session, bool arm);
+
+  uint64_t tickNow();
+  static uint64_t clock(int id);
+
+  uint32_t tickTime;
+  uint64_t tickLast;
+  uint32_t timerCount;
+  int      epoll;
+  int      wake;
+  uint32_t count;
+
+  std::vector<YmodemReactorSession *> wheel;
+
+  YmodemReactorStats stats;
+  uint64_t           idleTime;
+};
+
+/* Variable declarations -----------------------------------------------------*/
+/* Variable definitions ------------------------------------------------------*/
+/* Function declarations -----------------------------------------------------*/
+/* Function definitions ------------------------------------------------------*/
+
+#endif /* __YMODEM_REACTOR_H */
@@ -0,0 +1,285 @@
+/**
+  ******************************************************************************
+  * @file    YmodemRing.h
+  * @author  SerialPortYmodem contributors
+  * @version v1.0
+  * @date    17-October-2026
+  * @brief   Header-only single-producer single-consumer byte ring.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>Copyright &copy; 2026 SerialPortYmodem contributors</center></h2>
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#ifndef __YMODEM_RING_H
+#define __YMODEM_RING_H
+
+/* Header includes -----------------------------------------------------------*/
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+
+/* Macro definitions ---------------------------------------------------------*/
+#define YMODEM_RING_CACHE_LINE  (64)
+
+/* Type definitions ----------------------------------------------------------*/
+
+/*
+ * One thread writes and another reads without a lock. The indices run freely and are
+ * masked with Size - 1 on access, so Size must be a power of two. Each index sits on its
+ * own cache line together with the copy of the other index its owner last loaded, and a
+ * side only loads the other index again when that copy does not cover a request.
+ */
+template<uint32_t Size>
+class YmodemRing
+{
+public:
+  YmodemRing();
+
+  uint32_t space();
+  uint32_t reserve(uint8_t **buff);
+  void commit(uint32_t len);
+  uint32_t write(const uint8_t *buff, uint32_t len);
+
+  uint32_t available();
+  uint32_t peek(const uint8_t **buff);
+  void release(uint32_t len);
+  uint32_t read(uint8_t *buff, uint32_t len);
+
+  void clear();
+
+private:
+  static_assert((Size != 0) && ((Size & (Size - 1)) == 0), "The ring size must be a power of two.");
+
+  uint32_t freeSpace(uint32_t need);
+  uint32_t usedSpace(uint32_t need);
+
+  alignas(YMODEM_RING_CACHE_LINE) std::atomic<uint32_t> head;
+  uint32_t                                              headTail;
+
+  alignas(YMODEM_RING_CACHE_LINE) std::atomic<uint32_t> tail;
+  uint32_t                                              tailHead;
+
+  alignas(YMODEM_RING_CACHE_LINE) uint8_t buffer[Size];
+};
+
+/* Variable declarations -----------------------------------------------------*/
+/* Variable definitions ------------------------------------------------------*/
+/* Function declarations -----------------------------------------------------*/
+/* Function definitions ------------------------------------------------------*/
+
+/**
+  * @brief  Ymodem ring constructor.
+  * @param  None.
+  * @return None.
+  */
+template<uint32_t Size>
+YmodemRing<Size>::YmodemRing()
+{
+  clear();
+}
+
+/**
+  * @brief  Get the free space of the ring.
+  * @note   Producer side.
+  * @param  None.
+  * @return The number of bytes that can be written.
+  */
+template<uint32_t Size>
+uint32_t YmodemRing<Size>::space()
+{
+  return freeSpace(Size);
+}
+
+/**
+  * @brief  Get the contiguous free space of the ring.
+  * @note   Producer side. The bytes are published by commit().
+  * @param  [out] buff: The start of the free space.
+  * @return The number of bytes that can be written at @buff.
+  */
+template<uint32_t Size>
+uint32_t YmodemRing<Size>::reserve(uint8_t **buff)
+{
+  uint32_t position = head.load(std::memory_order_relaxed);
+  uint32_t offset   = position & (Size - 1);
+  uint32_t room     = freeSpace(Size);
+
+  *buff = &(buffer[offset]);
+
+  return ((Size - offset) < room) ? (Size - offset) : room;
+}
+
+/**
+  * @brief  Publish bytes written into the reserved space.
+  * @note   Producer side.
+  * @param  [in] len: The number of bytes written, at most the reserved length.
+  * @return None.
+  */
+template<uint32_t Size>
+void YmodemRing<Size>::commit(uint32_t len)
+{
+  head.store(head.load(std::memory_order_relaxed) + len, std::memory_order_release);
+}
+
+/**
+  * @brief  Copy bytes into the ring.
+  * @note   Producer side.
+  * @param  [in] buff: The bytes to write.
+  * @param  [in] len:  The number of bytes to write.
+  * @return The number of bytes written, less than @len when the ring is full.
+  */
+template<uint32_t Size>
+uint32_t YmodemRing<Size>::write(const uint8_t *buff, uint32_t len)
+{
+  uint32_t position = head.load(std::memory_order_relaxed);
+  uint32_t offset   = position & (Size - 1);
+  uint32_t room     = freeSpace(len);
+  uint32_t size     = (len < room) ? len : room;
+  uint32_t first    = ((Size - offset) < size) ? (Size - offset) : size;
+
+  memcpy(&(buffer[offset]), buff, first);
+  memcpy(buffer, buff + first, size - first);
+
+  head.store(position + size, std::memory_order_release);
+
+  return size;
+}
+
+/**
+  * @brief  Get the number of bytes in the ring.
+  * @note   Consumer side.
+  * @param  None.
+  * @return The number of bytes that can be read.
+  */
+template<uint32_t Size>
+uint32_t YmodemRing<Size>::available()
+{
+  return usedSpace(Size);
+}
+
+/**
+  * @brief  Get the contiguous bytes at the front of the ring.
+  * @note   Consumer side. The bytes stay in the ring until release().
+  * @param  [out] buff: The start of the bytes.
+  * @return The number of bytes that can be read at @buff.
+  */
+template<uint32_t Size>
+uint32_t YmodemRing<Size>::peek(const uint8_t **buff)
+{
+  uint32_t position = tail.load(std::memory_order_relaxed);
+  uint32_t offset   = position & (Size - 1);
+  uint32_t used     = usedSpace(Size);
+
+  *buff = &(buffer[offset]);
+
+  return ((Size - offset) < used) ? (Size - offset) : used;
+}
+
+/**
+  * @brief  Drop bytes from the front of the ring.
+  * @note   Consumer side.
+  * @param  [in] len: The number of bytes consumed, at most the available length.
+  * @return None.
+  */
+template<uint32_t Size>
+void YmodemRing<Size>::release(uint32_t len)
+{
+  tail.store(tail.load(std::memory_order_relaxed) + len, std::memory_order_release);
+}
+
+/**
+  * @brief  Copy bytes out of the ring.
+  * @note   Consumer side.
+  * @param  [out] buff: The buffer to read into.
+  * @param  [in]  len:  The maximum number of bytes to read.
+  * @return The number of bytes read.
+  */
+template<uint32_t Size>
+uint32_t YmodemRing<Size>::read(uint8_t *buff, uint32_t len)
+{
+  uint32_t position = tail.load(std::memory_order_relaxed);
+  uint32_t offset   = position & (Size - 1);
+  uint32_t used     = usedSpace(len);
+  uint32_t size     = (len < used) ? len : used;
+  uint32_t first    = ((Size - offset) < size) ? (Size - offset) : size;
+
+  memcpy(buff, &(buffer[offset]), first);
+  memcpy(buff + first, buffer, size - first);
+
+  tail.store(position + size, std::memory_order_release);
+
+  return size;
+}
+
+/**
+  * @brief  Empty the ring.
+  * @note   Neither side may use the ring at the same time.
+  * @param  None.
+  * @return None.
+  */
+template<uint32_t Size>
+void YmodemRing<Size>::clear()
+{
+  head.store(0, std::memory_order_relaxed);
+  tail.store(0, std::memory_order_relaxed);
+
+  headTail = 0;
+  tailHead = 0;
+}
+
+/**
+  * @brief  Get the free space of the ring as seen by the producer.
+  * @note   The consumer position is loaded again when the cached copy leaves less than
+  *         @need bytes free.
+  * @param  [in] need: The number of bytes the caller wants to write.
+  * @return The number of bytes that can be written.
+  */
+template<uint32_t Size>
+uint32_t YmodemRing<Size>::freeSpace(uint32_t need)
+{
+  uint32_t position = head.load(std::memory_order_relaxed);
+
+  if((Size - (position - headTail)) < need)
+  {
+    headTail = tail.load(std::memory_order_acquire);
+  }
+
+  return Size - (position - headTail);
+}
+
+/**
+  * @brief  Get the number of bytes in the ring as seen by the consumer.
+  * @note   The producer position is loaded again when the cached copy holds less than
+  *         @need bytes.
+  * @param  [in] need: The number of bytes the caller wants to read.
+  * @return The number of bytes that can be read.
+  */
+template<uint32_t Size>
+uint32_t YmodemRing<Size>::usedSpace(uint32_t need)
+{
+  uint32_t position = tail.load(std::memory_order_relaxed);
+
+  if((tailHead - position) < need)
+  {
+    tailHead = head.load(std::memory_order_acquire);
+  }
+
+  return tailHead - position;
+}
+
+#endif /* __YMODEM_RING_H */
@@ -0,0 +1,453 @@
+/**
+  ******************************************************************************
+  * @file    YmodemSerialThread.cpp
+  * @author  SerialPortYmodem contributors
+  * @version v1.0
+  * @date    17-October-2026
+  * @brief   Ymodem serial I/O thread module source file.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>Copyright &copy; 2026 SerialPortYmodem contributors</center></h2>
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+/* Header includes -----------------------------------------------------------*/
+#include "YmodemSerialThread.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+/* Macro definitions ---------------------------------------------------------*/
+#define YMODEM_SERIAL_DRAIN_TIME    (100)
+
+/* Type definitions ----------------------------------------------------------*/
+/* Variable declarations -----------------------------------------------------*/
+/* Variable definitions ------------------------------------------------------*/
+/* Function declarations -----------------------------------------------------*/
+/* Function definitions ------------------------------------------------------*/
+
+/**
+  * @brief  Ymodem serial thread constructor.
+  * @param  None.
+  * @return None.
+  */
+YmodemSerialThread::YmodemSerialThread()
+{
+  fd          = -1;
+  ioEvent     = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  engineEvent = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+
+  running.store(false);
+  stopping.store(false);
+  rxPaused.store(false);
+  txIdle.store(false);
+  engineWaiting.store(false);
+
+  memset(&stats, 0, sizeof(stats));
+}
+
+/**
+  * @brief  Ymodem serial thread destructor.
+  * @note   The file descriptor is owned by the caller and is not closed.
+  * @param  None.
+  * @return None.
+  */
+YmodemSerialThread::~YmodemSerialThread()
+{
+  stop();
+
+  close(ioEvent);
+  close(engineEvent);
+}
+
+/**
+  * @brief  Start the I/O thread on a port.
+  * @param  [in] fd: The file descriptor of the port, switched to non-blocking mode.
+  * @return Success or failure.
+  */
+bool YmodemSerialThread::start(int fd)
+{
+  stop();
+
+  if((ioEvent < 0) || (engineEvent < 0) || (fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK) != 0))
+  {
+    return false;
+  }
+
+  this->fd = fd;
+
+  rxRing.clear();
+  txRing.clear();
+
+  memset(&stats, 0, sizeof(stats));
+
+  running.store(true);
+  stopping.store(false);
+  rxPaused.store(false);
+  txIdle.store(false);
+  engineWaiting.store(false);
+
+  thread = std::thread(&YmodemSerialThread::run, this);
+
+  return true;
+}
+
+/**
+  * @brief  Stop the I/O thread.
+  * @note   The bytes still in the transmit ring are written first, for at most
+  *         YMODEM_SERIAL_DRAIN_TIME milliseconds, so the last ACK of a session is sent.
+  * @param  None.
+  * @return None.
+  */
+void YmodemSerialThread::stop()
+{
+  if(thread.joinable() == true)
+  {
+    stopping.store(true);
+
+    wake(ioEvent);
+
+    thread.join();
+  }
+
+  fd = -1;
+}
+
+/**
+  * @brief  Whether the I/O thread is running.
+  * @note   The thread stops by itself when the port reports an error or hangs up.
+  * @param  None.
+  * @return The I/O thread is running.
+  */
+bool YmodemSerialThread::isRunning()
+{
+  return running.load();
+}
+
+/**
+  * @brief  Read the bytes in the receive ring.
+  * @note   Called from the protocol thread. Reading from a full ring lets the I/O thread
+  *         drain the port again.
+  * @param  [out] buff: The buffer to read into.
+  * @param  [in]  len:  The maximum length to read.
+  * @return The length read.
+  */
+uint32_t YmodemSerialThread::read(uint8_t *buff, uint32_t len)
+{
+  uint32_t size = rxRing.read(buff, len);
+
+  if(size > 0)
+  {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if(rxPaused.exchange(false) == true)
+    {
+      wake(ioEvent);
+    }
+  }
+
+  return size;
+}
+
+/**
+  * @brief  Write bytes into the transmit ring.
+  * @note   Called from the protocol thread. While the ring is full the call waits for
+  *         the I/O thread, so no byte is dropped as long as the thread runs.
+  * @param  [in] buff: The bytes to write.
+  * @param  [in] len:  The length to write.
+  * @return The length written.
+  */
+uint32_t YmodemSerialThread::write(uint8_t *buff, uint32_t len)
+{
+  uint32_t count = 0;
+
+  while(count < len)
+  {
+    uint32_t size = txRing.write(buff + count, len - count);
+
+    count += size;
+
+    if(size > 0)
+    {
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+
+      if(txIdle.exchange(false) == true)
+      {
+        wake(ioEvent);
+      }
+    }
+    else
+    {
+      engineWaiting.store(true);
+
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+
+      if(running.load() != true)
+      {
+        engineWaiting.store(false);
+
+        break;
+      }
+
+      if(txRing.space() == 0)
+      {
+        sleep(engineEvent, YMODEM_SERIAL_DRAIN_TIME);
+      }
+
+      engineWaiting.store(false);
+    }
+  }
+
+  return count;
+}
+
+/**
+  * @brief  Wait until bytes are received.
+  * @note   Called from the protocol thread with the time from getTimeToDeadline().
+  * @param  [in] timeout: The longest time to wait in milliseconds.
+  * @return There are bytes in the receive ring.
+  */
+bool YmodemSerialThread::wait(uint32_t timeout)
+{
+  if(rxRing.available() > 0)
+  {
+    return true;
+  }
+
+  engineWaiting.store(true);
+
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  if((timeout > 0) && (running.load() == true) && (rxRing.available() == 0))
+  {
+    sleep(engineEvent, (int)(timeout));
+  }
+
+  engineWaiting.store(false);
+
+  return rxRing.available() > 0;
+}
+
+/**
+  * @brief  Get the I/O statistics.
+  * @note   The statistics are written by the I/O thread, read them after stop().
+  * @param  None.
+  * @return The I/O statistics.
+  */
+const YmodemSerialStats &YmodemSerialThread::getStats()
+{
+  return stats;
+}
+
+/**
+  * @brief  Move bytes between the port and the rings.
+  * @note   The thread reads and writes until neither direction moves, then announces
+  *         what it is waiting for and checks the rings once more before it sleeps. The
+  *         protocol thread checks the same flags after it moves a ring index, so one of
+  *         the two always sees the other.
+  * @param  None.
+  * @return None.
+  */
+void YmodemSerialThread::run()
+{
+  struct pollfd fds[2];
+
+  uint64_t drain = 0;
+  bool     full  = false;
+
+  while(true)
+  {
+    uint8_t       *input  = NULL;
+    const uint8_t *output = NULL;
+    uint32_t       room   = rxRing.reserve(&input);
+    uint32_t       length = txRing.peek(&output);
+    uint32_t       queued = txRing.available();
+    bool           moved  = false;
+
+    if(queued > stats.txPeak)
+    {
+      stats.txPeak = queued;
+    }
+
+    if(room > 0)
+    {
+      ssize_t number = ::read(fd, input, room);
+
+      if(number > 0)
+      {
+        rxRing.commit((uint32_t)(number));
+
+        stats.bytesRead += number;
+        moved            = true;
+        full             = false;
+
+        uint32_t used = YMODEM_SERIAL_RING_SIZE - rxRing.space();
+
+        if(used > stats.rxPeak)
+        {
+          stats.rxPeak = used;
+        }
+      }
+      else if((number == 0) || ((errno != EAGAIN) && (errno != EINTR)))
+      {
+        break;
+      }
+    }
+    else if(full != true)
+    {
+      stats.rxFull++;
+
+      full = true;
+    }
+
+    if(length > 0)
+    {
+      ssize_t number = ::write(fd, output, length);
+
+      if(number > 0)
+      {
+        txRing.release((uint32_t)(number));
+
+        stats.bytesWritten += number;
+        moved               = true;
+      }
+      else if((number < 0) && (errno != EAGAIN) && (errno != EINTR))
+      {
+        break;
+      }
+    }
+
+    if(moved == true)
+    {
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+
+      if(engineWaiting.exchange(false) == true)
+      {
+        wake(engineEvent);
+      }
+
+      continue;
+    }
+
+    if(stopping.load() == true)
+    {
+      uint64_t now = YmodemClock::tick();
+
+      if(drain == 0)
+      {
+        drain = now + YMODEM_SERIAL_DRAIN_TIME;
+      }
+
+      if((length == 0) || (now >= drain))
+      {
+        break;
+      }
+    }
+
+    rxPaused.store(room == 0);
+    txIdle.store(length == 0);
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if(((room == 0) && (rxRing.space() > 0)) || ((length == 0) && (txRing.available() > 0)))
+    {
+      rxPaused.store(false);
+      txIdle.store(false);
+
+      continue;
+    }
+
+    fds[0].fd      = fd;
+    fds[0].events  = ((room > 0) ? POLLIN : 0) | ((length > 0) ? POLLOUT : 0);
+    fds[0].revents = 0;
+    fds[1].fd      = ioEvent;
+    fds[1].events  = POLLIN;
+    fds[1].revents = 0;
+
+    if((poll(fds, 2, (stopping.load() == true) ? YMODEM_SERIAL_DRAIN_TIME : -1) < 0) && (errno != EINTR))
+    {
+      break;
+    }
+
+    if((fds[1].revents & POLLIN) != 0)
+    {
+      sleep(ioEvent, 0);
+    }
+
+    rxPaused.store(false);
+    txIdle.store(false);
+
+    stats.wakeups++;
+
+    if((fds[0].revents & (POLLERR | POLLNVAL)) != 0)
+    {
+      break;
+    }
+  }
+
+  running.store(false);
+
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  if(engineWaiting.exchange(false) == true)
+  {
+    wake(engineEvent);
+  }
+}
+
+/**
+  * @brief  Sleep until an eventfd is signalled or a timeout.
+  * @param  [in] fd:      The eventfd.
+  * @param  [in] timeout: The longest time to sleep in milliseconds.
+  * @return The eventfd was signalled.
+  */
+bool YmodemSerialThread::sleep(int fd, int timeout)
+{
+  struct pollfd event;
+
+  event.fd      = fd;
+  event.events  = POLLIN;
+  event.revents = 0;
+
+  if((poll(&event, 1, timeout) > 0) && ((event.revents & POLLIN) != 0))
+  {
+    uint64_t value = 0;
+
+    return ::read(fd, &value, sizeof(value)) == sizeof(value);
+  }
+
+  return false;
+}
+
+/**
+  * @brief  Signal an eventfd.
+  * @param  [in] fd: The eventfd.
+  * @return None.
+  */
+void YmodemSerialThread::wake(int fd)
+{
+  uint64_t value = 1;
+
+  if(::write(fd, &value, sizeof(value)) != sizeof(value))
+  {
+    return;
+  }
+}
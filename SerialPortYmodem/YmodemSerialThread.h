@@ -0,0 +1,198 @@
+/**
+  ******************************************************************************
+  * @file    YmodemSerialThread.h
+  * @author  SerialPortYmodem contributors
+  * @version v1.0
+  * @date    17-October-2026
+  * @brief   Header file for YmodemSerialThread.cpp module.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>Copyright &copy; 2026 SerialPortYmodem contributors</center></h2>
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#ifndef __YMODEM_SERIAL_THREAD_H
+#define __YMODEM_SERIAL_THREAD_H
+
+/* Header includes -----------------------------------------------------------*/
+#include <stdint.h>
+#include <atomic>
+#include <thread>
+#include "YmodemCore.h"
+#include "YmodemRing.h"
+
+/* Macro definitions ---------------------------------------------------------*/
+#define YMODEM_SERIAL_RING_SIZE     (64 * 1024)
+
+/* Type definitions ----------------------------------------------------------*/
+struct YmodemSerialStats
+{
+  uint64_t bytesRead;     /*!< Bytes moved from the port into the receive ring. */
+  uint64_t bytesWritten;  /*!< Bytes moved from the transmit ring to the port. */
+  uint64_t wakeups;       /*!< Times the I/O thread returned from poll. */
+  uint64_t rxFull;        /*!< Times the I/O thread stopped reading because the receive ring was full. */
+  uint32_t rxPeak;        /*!< Most bytes waiting in the receive ring. */
+  uint32_t txPeak;        /*!< Most bytes waiting in the transmit ring. */
+};
+
+/*
+ * Moves bytes between a port and two lock-free rings on its own thread, so the port is
+ * drained while the protocol is busy in a callback or between ticks. The protocol thread
+ * uses read(), write() and wait(); the I/O thread is the other end of both rings. Either
+ * side only wakes the other through an eventfd when the other is asleep on it.
+ * Only the ring benchmark uses it for now, the file wrappers still use QSerialPort.
+ */
+class YmodemSerialThread
+{
+public:
+  YmodemSerialThread();
+  ~YmodemSerialThread();
+
+  bool start(int fd);
+  void stop();
+  bool isRunning();
+
+  uint32_t read(uint8_t *buff, uint32_t len);
+  uint32_t write(uint8_t *buff, uint32_t len);
+  bool wait(uint32_t timeout);
+
+  const YmodemSerialStats &getStats();
+
+private:
+  void run();
+  bool sleep(int fd, int timeout);
+  void wake(int fd);
+
+  int fd;
+  int ioEvent;
+  int engineEvent;
+
+  std::thread       thread;
+  std::atomic<bool> running;
+  std::atomic<bool> stopping;
+
+  alignas(YMODEM_RING_CACHE_LINE) std::atomic<bool> rxPaused;
+  alignas(YMODEM_RING_CACHE_LINE) std::atomic<bool> txIdle;
+  alignas(YMODEM_RING_CACHE_LINE) std::atomic<bool> engineWaiting;
+
+  YmodemRing<YMODEM_SERIAL_RING_SIZE> rxRing;
+  YmodemRing<YMODEM_SERIAL_RING_SIZE> txRing;
+
+  YmodemSerialStats stats;
+};
+
+/*
+ * Transport for YmodemCore that reads and writes through a YmodemSerialThread. A class
+ * derived from it adds callback().
+ */
+class YmodemSerialTransport
+{
+public:
+  YmodemSerialTransport();
+
+  void setPort(YmodemSerialThread *port);
+  YmodemSerialThread *getPort();
+
+protected:
+  uint32_t read(uint8_t *buff, uint32_t len);
+  uint32_t write(uint8_t *buff, uint32_t len);
+  uint32_t tick();
+  uint64_t microTick();
+
+private:
+  YmodemSerialThread *port;
+};
+
+/* Variable declarations -----------------------------------------------------*/
+/* Variable definitions ------------------------------------------------------*/
+/* Function declarations -----------------------------------------------------*/
+/* Function definitions ------------------------------------------------------*/
+
+/**
+  * @brief  Ymodem serial transport constructor.
+  * @param  None.
+  * @return None.
+  */
+inline YmodemSerialTransport::YmodemSerialTransport()
+{
+  port = NULL;
+}
+
+/**
+  * @brief  Set the I/O thread of the port.
+  * @param  [in] port: The I/O thread, it must be set before the ymodem is called.
+  * @return None.
+  */
+inline void YmodemSerialTransport::setPort(YmodemSerialThread *port)
+{
+  this->port = port;
+}
+
+/**
+  * @brief  Get the I/O thread of the port.
+  * @param  None.
+  * @return The I/O thread.
+  */
+inline YmodemSerialThread *YmodemSerialTransport::getPort()
+{
+  return port;
+}
+
+/**
+  * @brief  Read the bytes in the receive ring.
+  * @param  [out] buff: The buffer to read into.
+  * @param  [in]  len:  The maximum length to read.
+  * @return The length read.
+  */
+inline uint32_t YmodemSerialTransport::read(uint8_t *buff, uint32_t len)
+{
+  return port->read(buff, len);
+}
+
+/**
+  * @brief  Write the bytes into the transmit ring.
+  * @param  [in] buff: The bytes to write.
+  * @param  [in] len:  The length to write.
+  * @return The length written.
+  */
+inline uint32_t YmodemSerialTransport::write(uint8_t *buff, uint32_t len)
+{
+  return port->write(buff, len);
+}
+
+/**
+  * @brief  Get the millisecond tick.
+  * @param  None.
+  * @return The tick in milliseconds.
+  */
+inline uint32_t YmodemSerialTransport::tick()
+{
+  return YmodemClock::tick();
+}
+
+/**
+  * @brief  Get the microsecond tick.
+  * @param  None.
+  * @return The tick in microseconds.
+  */
+inline uint64_t YmodemSerialTransport::microTick()
+{
+  return YmodemClock::microTick();
+}
+
+#endif /* __YMODEM_SERIAL_THREAD_H */
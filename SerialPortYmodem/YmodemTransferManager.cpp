@@ -0,0 +1,469 @@
+/**
+  ******************************************************************************
+  * @file    YmodemTransferManager.cpp
+  * @author  SerialPortYmodem contributors
+  * @version v1.0
+  * @date    16-October-2026
+  * @brief   Multi-port transfer manager with a work-stealing pool.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>Copyright &copy; 2026 SerialPortYmodem contributors</center></h2>
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#include "YmodemTransferManager.h"
+
+#define SESSION_COUNT   (8)
+
+YmodemTransferManager::YmodemTransferManager(QObject *parent) :
+    QObject(parent),
+    threadCount(qMax(QThread::idealThreadCount(), 1)),
+    sessionCount(SESSION_COUNT)
+{
+    qRegisterMetaType<Ymodem::Status>("Ymodem::Status");
+    qRegisterMetaType<YmodemFileTransmit::Status>("YmodemFileTransmit::Status");
+    qRegisterMetaType<YmodemFileReceive::Status>("YmodemFileReceive::Status");
+    qRegisterMetaType<YmodemFileTransmit::Stats>("YmodemFileTransmit::Stats");
+    qRegisterMetaType<YmodemFileReceive::Stats>("YmodemFileReceive::Stats");
+}
+
+YmodemTransferManager::~YmodemTransferManager()
+{
+    stop();
+
+    foreach(QThread *thread, threads)
+    {
+        thread->quit();
+        thread->wait();
+
+        delete thread;
+    }
+
+    qDeleteAll(queues);
+}
+
+void YmodemTransferManager::setThreadCount(int count)
+{
+    threadCount = qMax(count, 1);
+}
+
+void YmodemTransferManager::setSessionCount(int count)
+{
+    sessionCount = qMax(count, 1);
+}
+
+int YmodemTransferManager::addJob(const QString &portName, qint32 baudrate, const QString &fileName, Direction direction,
+                                  uint32_t options)
+{
+    Job job;
+
+    job.portName     = portName;
+    job.portBaudRate = baudrate;
+    job.fileName     = fileName;
+    job.direction    = direction;
+    job.options      = options;
+    job.state        = StatePending;
+    job.status       = Ymodem::StatusEstablish;
+    job.progress     = 0;
+    job.bytes        = 0;
+    job.startTime    = 0;
+    job.elapsed      = 0;
+
+    mutex.lock();
+
+    int id = jobs.size();
+
+    jobs.append(job);
+    remaining.fetchAndAddOrdered(1);
+
+    mutex.unlock();
+
+    if(queues.isEmpty() != true)
+    {
+        Queue *queue = queues.at(id % queues.size());
+
+        queue->mutex.lock();
+        queue->jobs.append(id);
+        queue->mutex.unlock();
+
+        foreach(YmodemTransferWorker *worker, workers)
+        {
+            QMetaObject::invokeMethod(worker, "schedule", Qt::QueuedConnection);
+        }
+    }
+
+    return id;
+}
+
+bool YmodemTransferManager::start()
+{
+    if(threads.isEmpty() != true)
+    {
+        return false;
+    }
+
+    timer.start();
+
+    for(int i = 0; i < threadCount; i++)
+    {
+        queues.append(new Queue);
+    }
+
+    mutex.lock();
+
+    for(int i = 0; i < jobs.size(); i++)
+    {
+        queues.at(i % threadCount)->jobs.append(i);
+    }
+
+    mutex.unlock();
+
+    for(int i = 0; i < threadCount; i++)
+    {
+        QThread              *thread = new QThread;
+        YmodemTransferWorker *worker = new YmodemTransferWorker(this, i, sessionCount);
+
+        worker->moveToThread(thread);
+
+        connect(thread, SIGNAL(finished()), worker, SLOT(deleteLater()));
+
+        threads.append(thread);
+        workers.append(worker);
+
+        thread->start();
+
+        QMetaObject::invokeMethod(worker, "schedule", Qt::QueuedConnection);
+    }
+
+    if(jobs.isEmpty() == true)
+    {
+        emit finished();
+    }
+
+    return true;
+}
+
+void YmodemTransferManager::stop()
+{
+    foreach(Queue *queue, queues)
+    {
+        QList<int> ids;
+
+        queue->mutex.lock();
+        ids.swap(queue->jobs);
+        queue->mutex.unlock();
+
+        foreach(int id, ids)
+        {
+            finishJob(id, Ymodem::StatusAbort, 0);
+        }
+    }
+
+    foreach(YmodemTransferWorker *worker, workers)
+    {
+        QMetaObject::invokeMethod(worker, "stopAll", Qt::QueuedConnection);
+    }
+}
+
+int YmodemTransferManager::getJobCount()
+{
+    QMutexLocker locker(&mutex);
+
+    return jobs.size();
+}
+
+YmodemTransferManager::Job YmodemTransferManager::getJob(int id)
+{
+    QMutexLocker locker(&mutex);
+
+    Job job = jobs.at(id);
+
+    if(job.state == StateRunning)
+    {
+        job.elapsed = timer.elapsed() - job.startTime;
+    }
+
+    return job;
+}
+
+int YmodemTransferManager::getFinishedCount()
+{
+    return finishedCount.loadAcquire();
+}
+
+quint64 YmodemTransferManager::getTotalBytes()
+{
+    QMutexLocker locker(&mutex);
+
+    quint64 bytes = 0;
+
+    foreach(const Job &job, jobs)
+    {
+        bytes += job.bytes;
+    }
+
+    return bytes;
+}
+
+double YmodemTransferManager::getThroughput()
+{
+    qint64 elapsed = timer.isValid() ? timer.elapsed() : 0;
+
+    return (elapsed > 0) ? (getTotalBytes() * 1000.0 / elapsed) : 0;
+}
+
+int YmodemTransferManager::takeJob(int index)
+{
+    int id = -1;
+
+    /* Take the oldest job of the own queue, otherwise steal the newest job of another queue. */
+    for(int i = 0; (i < queues.size()) && (id < 0); i++)
+    {
+        Queue *queue = queues.at((index + i) % queues.size());
+
+        queue->mutex.lock();
+
+        if(queue->jobs.isEmpty() != true)
+        {
+            id = (i == 0) ? queue->jobs.takeFirst() : queue->jobs.takeLast();
+        }
+
+        queue->mutex.unlock();
+    }
+
+    return id;
+}
+
+YmodemTransferManager::Job YmodemTransferManager::beginJob(int id)
+{
+    QMutexLocker locker(&mutex);
+
+    jobs[id].state     = StateRunning;
+    jobs[id].startTime = timer.elapsed();
+
+    return jobs.at(id);
+}
+
+void YmodemTransferManager::updateJob(int id, Ymodem::Status status, int progress, quint64 bytes)
+{
+    mutex.lock();
+
+    bool changed = (jobs.at(id).status != status);
+
+    jobs[id].status   = status;
+    jobs[id].progress = progress;
+    jobs[id].bytes    = bytes;
+
+    mutex.unlock();
+
+    if(changed == true)
+    {
+        emit jobStatus(id, status);
+    }
+}
+
+void YmodemTransferManager::finishJob(int id, Ymodem::Status status, quint64 bytes)
+{
+    mutex.lock();
+
+    if(jobs.at(id).state == StateRunning)
+    {
+        jobs[id].elapsed = timer.elapsed() - jobs.at(id).startTime;
+    }
+
+    jobs[id].state  = StateFinished;
+    jobs[id].status = status;
+    jobs[id].bytes  = bytes;
+
+    if(status == Ymodem::StatusFinish)
+    {
+        jobs[id].progress = 100;
+    }
+
+    mutex.unlock();
+
+    finishedCount.fetchAndAddOrdered(1);
+
+    emit jobStatus(id, status);
+
+    if(remaining.fetchAndAddOrdered(-1) == 1)
+    {
+        emit finished();
+    }
+}
+
+YmodemTransferWorker::YmodemTransferWorker(YmodemTransferManager *manager, int index, int sessionCount) :
+    manager(manager),
+    index(index),
+    sessionCount(sessionCount)
+{
+}
+
+void YmodemTransferWorker::schedule()
+{
+    while(sessions.size() < sessionCount)
+    {
+        int id = manager->takeJob(index);
+
+        if(id < 0)
+        {
+            break;
+        }
+
+        startJob(id);
+    }
+}
+
+void YmodemTransferWorker::stopAll()
+{
+    foreach(QObject *session, sessions.keys())
+    {
+        YmodemFileTransmit *transmit = qobject_cast<YmodemFileTransmit *>(session);
+        YmodemFileReceive  *receive  = qobject_cast<YmodemFileReceive *>(session);
+
+        if(transmit != NULL)
+        {
+            transmit->stopTransmit();
+        }
+        else if(receive != NULL)
+        {
+            receive->stopReceive();
+        }
+    }
+}
+
+void YmodemTransferWorker::transmitProgress(int progress)
+{
+    YmodemFileTransmit *session = qobject_cast<YmodemFileTransmit *>(sender());
+
+    if((session != NULL) && (sessions.contains(session) == true))
+    {
+        manager->updateJob(sessions.value(session), session->getTransmitStatus(), progress, session->getTransmitBytes());
+    }
+}
+
+void YmodemTransferWorker::receiveProgress(int progress)
+{
+    YmodemFileReceive *session = qobject_cast<YmodemFileReceive *>(sender());
+
+    if((session != NULL) && (sessions.contains(session) == true))
+    {
+        manager->updateJob(sessions.value(session), session->getReceiveStatus(), progress, session->getReceiveBytes());
+    }
+}
+
+void YmodemTransferWorker::transmitStatus(YmodemFileTransmit::Status status)
+{
+    YmodemFileTransmit *session = qobject_cast<YmodemFileTransmit *>(sender());
+
+    if(session != NULL)
+    {
+        sessionStatus(session, status, session->getTransmitBytes());
+    }
+}
+
+void YmodemTransferWorker::receiveStatus(YmodemFileReceive::Status status)
+{
+    YmodemFileReceive *session = qobject_cast<YmodemFileReceive *>(sender());
+
+    if(session != NULL)
+    {
+        sessionStatus(session, status, session->getReceiveBytes());
+    }
+}
+
+void YmodemTransferWorker::startJob(int id)
+{
+    YmodemTransferManager::Job job = manager->beginJob(id);
+
+    bool result = false;
+
+    if(job.direction == YmodemTransferManager::DirectionTransmit)
+    {
+        YmodemFileTransmit *session = new YmodemFileTransmit(this);
+
+        sessions.insert(session, id);
+
+        connect(session, SIGNAL(transmitProgress(int)), this, SLOT(transmitProgress(int)));
+        connect(session, SIGNAL(transmitStatus(YmodemFileTransmit::Status)), this, SLOT(transmitStatus(YmodemFileTransmit::Status)));
+
+        session->setFileName(job.fileName);
+        session->setPortName(job.portName);
+        session->setPortBaudRate(job.portBaudRate);
+        session->setOptions(job.options);
+
+        result = session->startTransmit();
+    }
+    else
+    {
+        YmodemFileReceive *session = new YmodemFileReceive(this);
+
+        sessions.insert(session, id);
+
+        connect(session, SIGNAL(receiveProgress(int)), this, SLOT(receiveProgress(int)));
+        connect(session, SIGNAL(receiveStatus(YmodemFileReceive::Status)), this, SLOT(receiveStatus(YmodemFileReceive::Status)));
+
+        session->setFilePath(job.fileName);
+        session->setPortName(job.portName);
+        session->setPortBaudRate(job.portBaudRate);
+        session->setOptions(job.options);
+
+        result = session->startReceive();
+    }
+
+    if(result != true)
+    {
+        QObject *session = sessions.key(id);
+
+        sessions.remove(session);
+        session->deleteLater();
+
+        manager->finishJob(id, Ymodem::StatusError, 0);
+    }
+}
+
+void YmodemTransferWorker::sessionStatus(QObject *session, Ymodem::Status status, quint64 bytes)
+{
+    if(sessions.contains(session) != true)
+    {
+        return;
+    }
+
+    int id = sessions.value(session);
+
+    switch(status)
+    {
+        case Ymodem::StatusEstablish:
+        case Ymodem::StatusTransmit:
+        {
+            manager->updateJob(id, status, manager->getJob(id).progress, bytes);
+
+            break;
+        }
+
+        default:
+        {
+            sessions.remove(session);
+            session->deleteLater();
+
+            manager->finishJob(id, status, bytes);
+
+            schedule();
+        }
+    }
+}
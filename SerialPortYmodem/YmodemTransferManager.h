@@ -0,0 +1,155 @@
+/**
+  ******************************************************************************
+  * @file    YmodemTransferManager.h
+  * @author  SerialPortYmodem contributors
+  * @version v1.0
+  * @date    16-October-2026
+  * @brief   Header file for YmodemTransferManager.cpp module.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>Copyright &copy; 2026 SerialPortYmodem contributors</center></h2>
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#ifndef YMODEMTRANSFERMANAGER_H
+#define YMODEMTRANSFERMANAGER_H
+
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QThread>
+#include <QVector>
+#include <QObject>
+#include <QAtomicInt>
+#include <QElapsedTimer>
+#include "YmodemFileTransmit.h"
+#include "YmodemFileReceive.h"
+
+class YmodemTransferWorker;
+
+class YmodemTransferManager : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Direction
+    {
+        DirectionTransmit,
+        DirectionReceive
+    };
+
+    enum State
+    {
+        StatePending,
+        StateRunning,
+        StateFinished
+    };
+
+    struct Job
+    {
+        QString        portName;
+        qint32         portBaudRate;
+        QString        fileName;
+        Direction      direction;
+        uint32_t       options;
+        State          state;
+        Ymodem::Status status;
+        int            progress;
+        quint64        bytes;
+        qint64         startTime;
+        qint64         elapsed;
+    };
+
+    explicit YmodemTransferManager(QObject *parent = 0);
+    ~YmodemTransferManager();
+
+    void setThreadCount(int count);
+    void setSessionCount(int count);
+
+    int addJob(const QString &portName, qint32 baudrate, const QString &fileName, Direction direction,
+               uint32_t options = Ymodem::OptionResume);
+
+    bool start();
+    void stop();
+
+    int getJobCount();
+    Job getJob(int id);
+    int getFinishedCount();
+    quint64 getTotalBytes();
+    double getThroughput();
+
+signals:
+    void jobStatus(int id, Ymodem::Status status);
+    void finished();
+
+private:
+    struct Queue
+    {
+        QMutex     mutex;
+        QList<int> jobs;
+    };
+
+    friend class YmodemTransferWorker;
+
+    int takeJob(int index);
+    Job beginJob(int id);
+    void updateJob(int id, Ymodem::Status status, int progress, quint64 bytes);
+    void finishJob(int id, Ymodem::Status status, quint64 bytes);
+
+    int threadCount;
+    int sessionCount;
+
+    QMutex        mutex;
+    QVector<Job>  jobs;
+    QElapsedTimer timer;
+    QAtomicInt    remaining;
+    QAtomicInt    finishedCount;
+
+    QList<Queue *>                queues;
+    QList<QThread *>              threads;
+    QList<YmodemTransferWorker *> workers;
+};
+
+class YmodemTransferWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    YmodemTransferWorker(YmodemTransferManager *manager, int index, int sessionCount);
+
+public slots:
+    void schedule();
+    void stopAll();
+
+private slots:
+    void transmitProgress(int progress);
+    void receiveProgress(int progress);
+    void transmitStatus(YmodemFileTransmit::Status status);
+    void receiveStatus(YmodemFileReceive::Status status);
+
+private:
+    void startJob(int id);
+    void sessionStatus(QObject *session, Ymodem::Status status, quint64 bytes);
+
+    YmodemTransferManager *manager;
+    int                    index;
+    int                    sessionCount;
+    QHash<QObject *, int>  sessions;
+};
+
+#endif // YMODEMTRANSFERMANAGER_H
@@ -4,12 +4,16 @@
 #include <QFileDialog>
 #include <QSerialPortInfo>
 
+#define PROGRESS_TIME_OUT   (100)
+
 Widget::Widget(QWidget *parent) :
     QWidget(parent),
     ui(new Ui::Widget),
     serialPort(new QSerialPort),
     ymodemFileTransmit(new YmodemFileTransmit),
-    ymodemFileReceive(new YmodemFileReceive)
+    ymodemFileReceive(new YmodemFileReceive),
+    transferThread(new QThread),
+    progressTimer(new QTimer)
 {
     transmitButtonStatus = false;
     receiveButtonStatus  = false;
@@ -30,18 +34,32 @@ Widget::Widget(QWidget *parent) :
     serialPort->setParity(QSerialPort::NoParity);
     serialPort->setFlowControl(QSerialPort::NoFlowControl);
 
-    connect(ymodemFileTransmit, SIGNAL(transmitProgress(int)), this, SLOT(transmitProgress(int)));
-    connect(ymodemFileReceive, SIGNAL(receiveProgress(int)), this, SLOT(receiveProgress(int)));
+    qRegisterMetaType<YmodemFileTransmit::Status>("YmodemFileTransmit::Status");
+    qRegisterMetaType<YmodemFileReceive::Status>("YmodemFileReceive::Status");
+    qRegisterMetaType<YmodemFileTransmit::Stats>("YmodemFileTransmit::Stats");
+    qRegisterMetaType<YmodemFileReceive::Stats>("YmodemFileReceive::Stats");
+
+    ymodemFileTransmit->moveToThread(transferThread);
+    ymodemFileReceive->moveToThread(transferThread);
+
+    transferThread->start();
+
+    connect(progressTimer, SIGNAL(timeout()), this, SLOT(progressTimeOut()));
     connect(ymodemFileTransmit, SIGNAL(transmitStatus(YmodemFileTransmit::Status)), this, SLOT(transmitStatus(YmodemFileTransmit::Status)));
     connect(ymodemFileReceive, SIGNAL(receiveStatus(YmodemFileReceive::Status)), this, SLOT(receiveStatus(YmodemFileReceive::Status)));
 }
 
 Widget::~Widget()
 {
+    transferThread->quit();
+    transferThread->wait();
+
     delete ui;
     delete serialPort;
     delete ymodemFileTransmit;
     delete ymodemFileReceive;
+    delete transferThread;
+    delete progressTimer;
 }
 
 void Widget::on_comButton_clicked()
@@ -63,6 +81,7 @@ void Widget::on_comButton_clicked()
 
             ui->transmitBrowse->setEnabled(true);
             ui->receiveBrowse->setEnabled(true);
+            ui->receiveMode->setEnabled(true);
 
             if(ui->transmitPath->text().isEmpty() != true)
             {
@@ -93,13 +112,16 @@ void Widget::on_comButton_clicked()
         ui->transmitButton->setDisabled(true);
 
         ui->receiveBrowse->setDisabled(true);
+        ui->receiveMode->setDisabled(true);
         ui->receiveButton->setDisabled(true);
     }
 }
 
 void Widget::on_transmitBrowse_clicked()
 {
-    ui->transmitPath->setText(QFileDialog::getOpenFileName(this, u8"打开文件", ".", u8"任意文件 (*.*)"));
+    transmitFiles = QFileDialog::getOpenFileNames(this, u8"打开文件", ".", u8"任意文件 (*.*)");
+
+    ui->transmitPath->setText(transmitFiles.join("; "));
 
     if(ui->transmitPath->text().isEmpty() != true)
     {
@@ -131,7 +153,7 @@ void Widget::on_transmitButton_clicked()
     {
         serialPort->close();
 
-        ymodemFileTransmit->setFileName(ui->transmitPath->text());
+        ymodemFileTransmit->setFileNames(transmitFiles);
         ymodemFileTransmit->setPortName(ui->comPort->currentText());
         ymodemFileTransmit->setPortBaudRate(ui->comBaudRate->currentText().toInt());
 
@@ -142,11 +164,14 @@ void Widget::on_transmitButton_clicked()
             ui->comButton->setDisabled(true);
 
             ui->receiveBrowse->setDisabled(true);
+            ui->receiveMode->setDisabled(true);
             ui->receiveButton->setDisabled(true);
 
             ui->transmitBrowse->setDisabled(true);
             ui->transmitButton->setText(u8"取消");
             ui->transmitProgress->setValue(0);
+
+            progressTimer->start(PROGRESS_TIME_OUT);
         }
         else
         {
@@ -169,6 +194,35 @@ void Widget::on_receiveButton_clicked()
         ymodemFileReceive->setPortName(ui->comPort->currentText());
         ymodemFileReceive->setPortBaudRate(ui->comBaudRate->currentText().toInt());
 
+        switch(ui->receiveMode->currentIndex())
+        {
+            case 1:
+            {
+                ymodemFileReceive->setOptions(Ymodem::OptionStreaming | Ymodem::OptionResume);
+
+                break;
+            }
+
+            case 2:
+            {
+                ymodemFileReceive->setOptions(Ymodem::OptionWindow | Ymodem::OptionResume);
+
+                break;
+            }
+
+            case 3:
+            {
+                ymodemFileReceive->setOptions(Ymodem::OptionExtended | Ymodem::OptionResume);
+
+                break;
+            }
+
+            default:
+            {
+                ymodemFileReceive->setOptions(Ymodem::OptionResume);
+            }
+        }
+
         if(ymodemFileReceive->startReceive() == true)
         {
             receiveButtonStatus = true;
@@ -179,8 +233,11 @@ void Widget::on_receiveButton_clicked()
             ui->transmitButton->setDisabled(true);
 
             ui->receiveBrowse->setDisabled(true);
+            ui->receiveMode->setDisabled(true);
             ui->receiveButton->setText(u8"取消");
             ui->receiveProgress->setValue(0);
+
+            progressTimer->start(PROGRESS_TIME_OUT);
         }
         else
         {
@@ -193,14 +250,17 @@ void Widget::on_receiveButton_clicked()
     }
 }
 
-void Widget::transmitProgress(int progress)
+void Widget::progressTimeOut()
 {
-    ui->transmitProgress->setValue(progress);
-}
+    if(transmitButtonStatus == true)
+    {
+        ui->transmitProgress->setValue(ymodemFileTransmit->getTransmitProgress());
+    }
 
-void Widget::receiveProgress(int progress)
-{
-    ui->receiveProgress->setValue(progress);
+    if(receiveButtonStatus == true)
+    {
+        ui->receiveProgress->setValue(ymodemFileReceive->getReceiveProgress());
+    }
 }
 
 void Widget::transmitStatus(Ymodem::Status status)
@@ -219,11 +279,15 @@ void Widget::transmitStatus(Ymodem::Status status)
 
         case YmodemFileTransmit::StatusFinish:
         {
+            progressTimeOut();
+            progressTimer->stop();
+
             transmitButtonStatus = false;
 
             ui->comButton->setEnabled(true);
 
             ui->receiveBrowse->setEnabled(true);
+            ui->receiveMode->setEnabled(true);
 
             if(ui->receivePath->text().isEmpty() != true)
             {
@@ -240,11 +304,15 @@ void Widget::transmitStatus(Ymodem::Status status)
 
         case YmodemFileTransmit::StatusAbort:
         {
+            progressTimeOut();
+            progressTimer->stop();
+
             transmitButtonStatus = false;
 
             ui->comButton->setEnabled(true);
 
             ui->receiveBrowse->setEnabled(true);
+            ui->receiveMode->setEnabled(true);
 
             if(ui->receivePath->text().isEmpty() != true)
             {
@@ -261,11 +329,15 @@ void Widget::transmitStatus(Ymodem::Status status)
 
         case YmodemFileTransmit::StatusTimeout:
         {
+            progressTimeOut();
+            progressTimer->stop();
+
             transmitButtonStatus = false;
 
             ui->comButton->setEnabled(true);
 
             ui->receiveBrowse->setEnabled(true);
+            ui->receiveMode->setEnabled(true);
 
             if(ui->receivePath->text().isEmpty() != true)
             {
@@ -282,11 +354,15 @@ void Widget::transmitStatus(Ymodem::Status status)
 
         default:
         {
+            progressTimeOut();
+            progressTimer->stop();
+
             transmitButtonStatus = false;
 
             ui->comButton->setEnabled(true);
 
             ui->receiveBrowse->setEnabled(true);
+            ui->receiveMode->setEnabled(true);
 
             if(ui->receivePath->text().isEmpty() != true)
             {
@@ -317,6 +393,9 @@ void Widget::receiveStatus(YmodemFileReceive::Status status)
 
         case YmodemFileReceive::StatusFinish:
         {
+            progressTimeOut();
+            progressTimer->stop();
+
             receiveButtonStatus = false;
 
             ui->comButton->setEnabled(true);
@@ -329,6 +408,7 @@ void Widget::receiveStatus(YmodemFileReceive::Status status)
             }
 
             ui->receiveBrowse->setEnabled(true);
+            ui->receiveMode->setEnabled(true);
             ui->receiveButton->setText(u8"接收");
 
             QMessageBox::warning(this, u8"成功", u8"文件接收成功！", u8"关闭");
@@ -338,6 +418,9 @@ void Widget::receiveStatus(YmodemFileReceive::Status status)
 
         case YmodemFileReceive::StatusAbort:
         {
+            progressTimeOut();
+            progressTimer->stop();
+
             receiveButtonStatus = false;
 
             ui->comButton->setEnabled(true);
@@ -350,6 +433,7 @@ void Widget::receiveStatus(YmodemFileReceive::Status status)
             }
 
             ui->receiveBrowse->setEnabled(true);
+            ui->receiveMode->setEnabled(true);
             ui->receiveButton->setText(u8"接收");
 
             QMessageBox::warning(this, u8"失败", u8"文件接收失败！", u8"关闭");
@@ -359,6 +443,9 @@ void Widget::receiveStatus(YmodemFileReceive::Status status)
 
         case YmodemFileReceive::StatusTimeout:
         {
+            progressTimeOut();
+            progressTimer->stop();
+
             receiveButtonStatus = false;
 
             ui->comButton->setEnabled(true);
@@ -371,6 +458,7 @@ void Widget::receiveStatus(YmodemFileReceive::Status status)
             }
 
             ui->receiveBrowse->setEnabled(true);
+            ui->receiveMode->setEnabled(true);
             ui->receiveButton->setText(u8"接收");
 
             QMessageBox::warning(this, u8"失败", u8"文件接收失败！", u8"关闭");
@@ -380,6 +468,9 @@ void Widget::receiveStatus(YmodemFileReceive::Status status)
 
         default:
         {
+            progressTimeOut();
+            progressTimer->stop();
+
             receiveButtonStatus = false;
 
             ui->comButton->setEnabled(true);
@@ -392,6 +483,7 @@ void Widget::receiveStatus(YmodemFileReceive::Status status)
             }
 
             ui->receiveBrowse->setEnabled(true);
+            ui->receiveMode->setEnabled(true);
             ui->receiveButton->setText(u8"接收");
 
             QMessageBox::warning(this, u8"失败", u8"文件接收失败！", u8"关闭");
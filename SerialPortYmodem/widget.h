@@ -1,6 +1,8 @@
 #ifndef WIDGET_H
 #define WIDGET_H
 
+#include <QTimer>
+#include <QThread>
 #include <QWidget>
 #include "YmodemFileTransmit.h"
 #include "YmodemFileReceive.h"
@@ -23,8 +25,7 @@ private slots:
     void on_receiveBrowse_clicked();
     void on_transmitButton_clicked();
     void on_receiveButton_clicked();
-    void transmitProgress(int progress);
-    void receiveProgress(int progress);
+    void progressTimeOut();
     void transmitStatus(YmodemFileTransmit::Status status);
     void receiveStatus(YmodemFileReceive::Status status);
 
@@ -33,6 +34,9 @@ private:
     QSerialPort *serialPort;
     YmodemFileTransmit *ymodemFileTransmit;
     YmodemFileReceive *ymodemFileReceive;
+    QThread *transferThread;
+    QTimer *progressTimer;
+    QStringList transmitFiles;
 
     bool transmitButtonStatus;
     bool receiveButtonStatus;
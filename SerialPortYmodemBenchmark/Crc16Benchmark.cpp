@@ -0,0 +1,96 @@
+/**
+  ******************************************************************************
+  * @file    Crc16Benchmark.cpp
+  * @author  SerialPortYmodem contributors
+  * @version v1.0
+  * @date    16-October-2026
+  * @brief   CRC16 engine throughput benchmark.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>Copyright &copy; 2026 SerialPortYmodem contributors</center></h2>
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#include "Crc16Benchmark.h"
+#include "Crc16.h"
+#include <chrono>
+#include <vector>
+#include <stdio.h>
+#include <stdlib.h>
+
+static const Crc16Engine engines[] =
+{
+    Crc16EngineBitwise,
+    Crc16EngineTable,
+    Crc16EngineSlice8,
+    Crc16EngineClmul
+};
+
+int crc16Benchmark(uint32_t size, uint32_t milliseconds)
+{
+    std::vector<uint8_t> buff(size);
+
+    srand(0);
+
+    for(uint32_t i = 0; i < size; i++)
+    {
+        buff[i] = (uint8_t)(rand());
+    }
+
+    uint16_t reference = crc16Bitwise(0, buff.data(), size);
+
+    printf("%-10s %10s %12s %10s\n", "engine", "size", "MB/s", "crc");
+
+    for(Crc16Engine engine : engines)
+    {
+        if(crc16Supported(engine) != true)
+        {
+            continue;
+        }
+
+        uint16_t crc   = 0;
+        uint64_t bytes = 0;
+        auto     start = std::chrono::steady_clock::now();
+        auto     stop  = start + std::chrono::milliseconds(milliseconds);
+        auto     now   = start;
+
+        do
+        {
+            for(int i = 0; i < 64; i++)
+            {
+                crc    = crc16(engine, 0, buff.data(), size);
+                bytes += size;
+            }
+
+            now = std::chrono::steady_clock::now();
+        }
+        while(now < stop);
+
+        double seconds = std::chrono::duration<double>(now - start).count();
+
+        printf("%-10s %10u %12.1f %10s\n", crc16Name(engine), size,
+               bytes / seconds / 1000000.0, crc == reference ? "ok" : "MISMATCH");
+
+        if(crc != reference)
+        {
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,429 @@
+/**
+  ******************************************************************************
+  * @file    FaultBenchmark.cpp
+  * @author  SerialPortYmodem contributors
+  * @version v1.0
+  * @date    16-October-2026
+  * @brief   Recovery benchmark over a fault-injecting simulated link.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>Copyright &copy; 2026 SerialPortYmodem contributors</center></h2>
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#include "FaultBenchmark.h"
+#include "SimulatedLink.h"
+#include "MemoryTransfer.h"
+#include <chrono>
+#include <string>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Bytes a streaming transmitter keeps queued on the line, as the reactor does. */
+#define FAULT_STREAM_SIZE   (4 * (YMODEM_PACKET_1K_SIZE + YMODEM_PACKET_OVERHEAD))
+
+/* Virtual time after which a run that has not finished is reported as stalled. */
+#define FAULT_TIME_LIMIT    (24ULL * 3600 * 1000000000ULL)
+
+struct FaultConfig
+{
+  SimulatedFaults faults;
+  bool            reverse;
+  bool            adaptive;
+  uint32_t        size;
+  uint32_t        options;
+  uint32_t        seed;
+  uint32_t        runs;
+  uint32_t        timeDivide;
+  uint32_t        timeMax;
+  uint32_t        errorMax;
+  uint32_t        timeUnit;
+};
+
+class SimulatedTransmitSession : public SimulatedSession, public MemoryTransmitter
+{
+public:
+  SimulatedTransmitSession(SimulatedLink *link, uint32_t seed, uint32_t size) :
+    SimulatedSession(link, 0), MemoryTransmitter(seed, size)
+  {
+  }
+
+protected:
+  Code sessionCallback(Status status, uint8_t *buff, uint32_t *len)
+  {
+    return transfer(status, buff, len);
+  }
+};
+
+class SimulatedReceiveSession : public SimulatedSession, public MemoryReceiver
+{
+public:
+  SimulatedReceiveSession(SimulatedLink *link, uint32_t options) :
+    SimulatedSession(link, 1)
+  {
+    setOptions(options);
+  }
+
+protected:
+  Code sessionCallback(Status status, uint8_t *buff, uint32_t *len)
+  {
+    return transfer(status, buff, len);
+  }
+};
+
+static const char *statusName(Ymodem::Status status)
+{
+  switch(status)
+  {
+    case Ymodem::StatusEstablish: return "stalled";
+    case Ymodem::StatusTransmit:  return "stalled";
+    case Ymodem::StatusFinish:    return "finish";
+    case Ymodem::StatusAbort:     return "abort";
+    case Ymodem::StatusTimeout:   return "timeout";
+    default:                      return "error";
+  }
+}
+
+static void faultStep(SimulatedSession &session, uint32_t side)
+{
+  if(side == 0)
+  {
+    session.transmit();
+  }
+  else
+  {
+    session.receive();
+  }
+}
+
+/**
+  * @brief  Run one session at the current virtual time, the way the reactor would.
+  * @param  link:     The link the session is on.
+  * @param  session:  The session to run.
+  * @param  side:     The side of the link the session writes to.
+  * @param  deadline: The virtual time of the session deadline, updated on return.
+  */
+static void faultService(SimulatedLink &link, SimulatedSession &session, uint32_t side, uint64_t *deadline)
+{
+  SimulatedChannel &input  = link.getChannel(side ^ 1);
+  SimulatedChannel &output = link.getChannel(side);
+
+  uint64_t now = link.getTime();
+
+  if(session.isFinished() == true)
+  {
+    return;
+  }
+
+  if(now >= *deadline)
+  {
+    faultStep(session, side);
+  }
+
+  while((session.isFinished() != true) && (input.available(now) > 0))
+  {
+    uint32_t available = input.available(now);
+
+    faultStep(session, side);
+
+    if(input.available(now) >= available)
+    {
+      break;
+    }
+  }
+
+  while((side == 0) && ((session.getSessionOptions() & Ymodem::OptionStreaming) != 0) &&
+        (session.isFinished() != true) && (output.backlog(now) < FAULT_STREAM_SIZE))
+  {
+    uint64_t line = output.getLineTime();
+
+    session.transmit();
+
+    if(output.getLineTime() <= line)
+    {
+      break;
+    }
+  }
+
+  *deadline = now + session.getTimeToDeadline() * 1000000ULL;
+}
+
+/**
+  * @brief  Transfer one payload over a simulated link and print a CSV row.
+  * @note   A recovery starts at the arrival of the first fault since the receiver last
+  *         accepted data and ends when it next accepts data, or when the run ends.
+  * @param  config: The run settings.
+  * @param  seed:   The seed of the link.
+  * @return 1 when the receiver accepted data that does not match, an extended session
+  *         on a clean line never sent an extended packet, or an adaptive session with
+  *         acknowledgements did not finish with bit errors up to 1e-3 alone, 0 otherwise.
+  */
+static int faultRun(const FaultConfig &config, uint32_t seed)
+{
+  SimulatedLink            link;
+  SimulatedTransmitSession transmitter(&link, seed, config.size);
+  SimulatedReceiveSession  receiver(&link, config.options);
+  SimulatedFaults          clean;
+
+  memset(&clean, 0, sizeof(clean));
+
+  clean.latency  = config.faults.latency;
+  clean.baudrate = config.faults.baudrate;
+
+  link.setSeed(seed);
+  link.setFaults(0, config.faults);
+  link.setFaults(1, (config.reverse == true) ? config.faults : clean);
+
+  SimulatedSession *sessions[2] = {&transmitter, &receiver};
+
+  for(uint32_t i = 0; i < 2; i++)
+  {
+    sessions[i]->setTimeDivide(config.timeDivide);
+    sessions[i]->setTimeMax(config.timeMax);
+    sessions[i]->setErrorMax(config.errorMax);
+    sessions[i]->setTimeUnit(config.timeUnit);
+    sessions[i]->setAdaptive(config.adaptive);
+  }
+
+  uint64_t deadlines[2]  = {0, 0};
+  uint64_t faultStart    = UINT64_MAX;
+  uint64_t recoveries    = 0;
+  uint64_t recoveryTotal = 0;
+  uint64_t recoveryMax   = 0;
+  uint32_t count         = 0;
+
+  uint64_t start = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch()).count();
+
+  while(((transmitter.isFinished() != true) || (receiver.isFinished() != true)) &&
+        (link.getTime() < FAULT_TIME_LIMIT))
+  {
+    uint64_t now  = link.getTime();
+    uint64_t next = UINT64_MAX;
+    uint64_t fault;
+
+    for(uint32_t i = 0; i < 2; i++)
+    {
+      faultService(link, *sessions[i], i, &deadlines[i]);
+    }
+
+    if(receiver.getCount() > count)
+    {
+      count = receiver.getCount();
+
+      if(faultStart <= now)
+      {
+        recoveries++;
+        recoveryTotal += now - faultStart;
+        recoveryMax    = ((now - faultStart) > recoveryMax) ? (now - faultStart) : recoveryMax;
+        faultStart     = UINT64_MAX;
+      }
+    }
+
+    for(uint32_t i = 0; i < 2; i++)
+    {
+      if((link.getChannel(i).takeFault(now, &fault) == true) && (fault < faultStart))
+      {
+        faultStart = fault;
+      }
+
+      if(sessions[i]->isFinished() != true)
+      {
+        next = (deadlines[i] < next) ? deadlines[i] : next;
+      }
+
+      next = (link.getChannel(i).getNextArrival(now) < next) ? link.getChannel(i).getNextArrival(now) : next;
+    }
+
+    if(((transmitter.getSessionOptions() & Ymodem::OptionStreaming) != 0) && (transmitter.isFinished() != true) &&
+       (link.getChannel(0).backlog(now) >= FAULT_STREAM_SIZE))
+    {
+      uint64_t drain = link.getChannel(0).getLineTime() -
+                       FAULT_STREAM_SIZE * (10000000000ULL / config.faults.baudrate) + 1;
+
+      next = (drain < next) ? drain : next;
+    }
+
+    if((transmitter.isFinished() == true) && (receiver.isFinished() == true))
+    {
+      break;
+    }
+
+    /* A session whose deadline has already passed is stepped again a millisecond later. */
+    link.setTime((next > now) ? next : now + 1000000);
+  }
+
+  uint64_t stop = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                  std::chrono::steady_clock::now().time_since_epoch()).count();
+
+  if(faultStart != UINT64_MAX)
+  {
+    recoveries++;
+    recoveryTotal += link.getTime() - faultStart;
+    recoveryMax    = ((link.getTime() - faultStart) > recoveryMax) ? (link.getTime() - faultStart) : recoveryMax;
+  }
+
+  SimulatedStats forward = link.getChannel(0).getStats();
+  SimulatedStats reverse = link.getChannel(1).getStats();
+  Ymodem::Stats  txStats = transmitter.getTransferStats();
+  Ymodem::Stats  rxStats = receiver.getTransferStats();
+
+  bool finish = (transmitter.getStatus() == Ymodem::StatusFinish) && (receiver.getStatus() == Ymodem::StatusFinish);
+  bool match  = (receiver.getCount() == config.size) && (receiver.getCrc() == transmitter.getCrc());
+  bool quiet  = (config.faults.bitErrorRate == 0) && (config.faults.dropRate == 0) &&
+                (config.faults.duplicateRate == 0) && (config.faults.burstRate == 0);
+
+  /* On a clean line an extended session must leave 1K once the adaptive size has had a chance. */
+  bool stuck  = (quiet == true) && (finish == true) && (config.adaptive == true) &&
+                ((transmitter.getSessionOptions() & Ymodem::OptionExtended) != 0) &&
+                (txStats.packetsExtended == 0) && (txStats.packets1K > 2 * YMODEM_ADAPT_PERIOD);
+
+  /* With bit errors up to 1e-3 alone, splitting the failing packets must get an acknowledged session through. */
+  bool split  = (config.adaptive == true) && (config.faults.bitErrorRate <= 1e-3) && (config.faults.dropRate == 0) &&
+                (config.faults.duplicateRate == 0) && (config.faults.burstRate == 0) &&
+                ((config.options & (Ymodem::OptionStreaming | Ymodem::OptionWindow)) == 0);
+
+  const char *status = (match != true) ? "mismatch" : (stuck == true) ? "stuck" : "finish";
+
+  if(transmitter.getStatus() != Ymodem::StatusFinish)
+  {
+    status = statusName(transmitter.getStatus());
+  }
+  else if(receiver.getStatus() != Ymodem::StatusFinish)
+  {
+    status = statusName(receiver.getStatus());
+  }
+
+  double seconds = link.getTime() / 1000000000.0;
+  double goodput = (finish == true) && (seconds > 0) ? (config.size / seconds) : 0.0;
+
+  printf("%u,%u,%u,%u,%s,%.3f,%.0f,%.4f,%u,%u,%u,%u,%u,%u,%u,%.2f,%.2f,%u,%u,%u,%u,%llu,%.1f,%.1f,%llu,%llu,%llu,%llu,%.1f\n",
+         seed, config.size, config.faults.baudrate, config.options, status, seconds, goodput,
+         goodput / (config.faults.baudrate / 10.0), transmitter.getRetryCount(), receiver.getRetryCount(),
+         txStats.naks, txStats.timeouts, rxStats.timeouts, rxStats.crcErrors, rxStats.duplicates,
+         txStats.rttAverage / 1000.0, txStats.rttP99 / 1000.0, txStats.sizeChanges, txStats.packets128,
+         txStats.packets1K, txStats.packetsExtended, (unsigned long long)(recoveries),
+         (recoveries != 0) ? (recoveryTotal / 1000000.0 / recoveries) : 0.0, recoveryMax / 1000000.0,
+         (unsigned long long)(forward.bitsFlipped + reverse.bitsFlipped),
+         (unsigned long long)(forward.bytesDropped + reverse.bytesDropped),
+         (unsigned long long)(forward.bytesDuplicated + reverse.bytesDuplicated),
+         (unsigned long long)(forward.bursts + reverse.bursts), (stop - start) / 1000000.0);
+  fflush(stdout);
+
+  /* Failing to finish on a bad enough line is expected; accepting corrupted data is not. */
+  return (((finish == true) && (match != true)) || (stuck == true) || ((split == true) && (finish != true))) ? 1 : 0;
+}
+
+static void faultUsage()
+{
+  printf("settings, as key=value:\n");
+  printf("  size=<bytes>      payload size, with an optional K/M suffix (64K)\n");
+  printf("  options=<n>       receiver protocol options (0)\n");
+  printf("  seed=<n>          seed of the first run (1)\n");
+  printf("  runs=<n>          number of runs, one seed each (1)\n");
+  printf("  baud=<n>          line rate (115200)\n");
+  printf("  latency=<us>      one-way latency in microseconds (0)\n");
+  printf("  ber=<rate>        bit error rate (1e-5)\n");
+  printf("  drop=<rate>       byte drop rate (0)\n");
+  printf("  dup=<rate>        byte duplication rate (0)\n");
+  printf("  burst=<rate>      noise burst rate per byte (0)\n");
+  printf("  burstlen=<bytes>  noise burst length (16)\n");
+  printf("  reverse=<0|1>     inject faults into the acknowledgement direction too (1)\n");
+  printf("  adaptive=<0|1>    adapt the packet size to the error rate (1)\n");
+  printf("  divide=<n> max=<n> errors=<n> unit=<ms>\n");
+  printf("                    ymodem timeDivide, timeMax, errorMax and timeUnit (499, 5, 999, 10)\n");
+}
+
+int faultBenchmark(int argc, char *argv[])
+{
+  FaultConfig config;
+
+  memset(&config, 0, sizeof(config));
+
+  config.faults.bitErrorRate = 1e-5;
+  config.faults.burstLength  = 16;
+  config.faults.baudrate     = 115200;
+  config.reverse             = true;
+  config.adaptive            = true;
+  config.size                = 64 * 1024;
+  config.seed                = 1;
+  config.runs                = 1;
+  config.timeDivide          = 499;
+  config.timeMax             = 5;
+  config.errorMax            = 999;
+  config.timeUnit            = 10;
+
+  for(int i = 0; i < argc; i++)
+  {
+    char       *value = strchr(argv[i], '=');
+    char       *end   = NULL;
+    std::string key(argv[i], (value != NULL) ? (size_t)(value - argv[i]) : strlen(argv[i]));
+
+    if(value == NULL)
+    {
+      faultUsage();
+
+      return 2;
+    }
+
+    double   number  = strtod(value + 1, &end);
+    uint32_t integer = (uint32_t)(strtoul(value + 1, NULL, 0));
+
+    integer = (*end == 'K') || (*end == 'k') ? (uint32_t)(number * 1024) : integer;
+    integer = (*end == 'M') || (*end == 'm') ? (uint32_t)(number * 1024 * 1024) : integer;
+
+    if(key == "size")          config.size                 = integer;
+    else if(key == "options")  config.options              = integer;
+    else if(key == "seed")     config.seed                 = integer;
+    else if(key == "runs")     config.runs                 = integer;
+    else if(key == "baud")     config.faults.baudrate      = (integer != 0) ? integer : 115200;
+    else if(key == "latency")  config.faults.latency       = integer;
+    else if(key == "ber")      config.faults.bitErrorRate  = number;
+    else if(key == "drop")     config.faults.dropRate      = number;
+    else if(key == "dup")      config.faults.duplicateRate = number;
+    else if(key == "burst")    config.faults.burstRate     = number;
+    else if(key == "burstlen") config.faults.burstLength   = integer;
+    else if(key == "reverse")  config.reverse              = (integer != 0);
+    else if(key == "adaptive") config.adaptive             = (integer != 0);
+    else if(key == "divide")   config.timeDivide           = integer;
+    else if(key == "max")      config.timeMax              = integer;
+    else if(key == "errors")   config.errorMax             = integer;
+    else if(key == "unit")     config.timeUnit             = integer;
+    else
+    {
+      faultUsage();
+
+      return 2;
+    }
+  }
+
+  int result = 0;
+
+  printf("seed,size,baudrate,options,status,seconds,goodput,efficiency,tx_retries,rx_retries,tx_naks,"
+         "tx_timeouts,rx_timeouts,rx_crc_errors,rx_duplicates,rtt_avg_ms,rtt_p99_ms,size_changes,tx_packets_128,"
+         "tx_packets_1k,tx_packets_ext,recoveries,recovery_avg_ms,recovery_max_ms,bits_flipped,bytes_dropped,"
+         "bytes_duplicated,bursts,wall_ms\n");
+
+  for(uint32_t i = 0; i < config.runs; i++)
+  {
+    result |= faultRun(config, config.seed + i);
+  }
+
+  return result;
+}
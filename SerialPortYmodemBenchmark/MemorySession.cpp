@@ -0,0 +1,50 @@
+/**
+  ******************************************************************************
+  * @file    MemorySession.cpp
+  * @author  SerialPortYmodem contributors
+  * @version v1.0
+  * @date    16-October-2026
+  * @brief   Reactor sessions transferring generated data.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>Copyright &copy; 2026 SerialPortYmodem contributors</center></h2>
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#include "MemorySession.h"
+
+MemoryTransmitSession::MemoryTransmitSession(int fd, uint32_t seed, uint32_t size) :
+  YmodemReactorSession(fd, DirectionTransmit), MemoryTransmitter(seed, size)
+{
+}
+
+YmodemReactorSession::Code MemoryTransmitSession::sessionCallback(Status status, uint8_t *buff, uint32_t *len)
+{
+  return transfer(status, buff, len);
+}
+
+MemoryReceiveSession::MemoryReceiveSession(int fd, uint32_t options) :
+  YmodemReactorSession(fd, DirectionReceive)
+{
+  setOptions(options);
+}
+
+YmodemReactorSession::Code MemoryReceiveSession::sessionCallback(Status status, uint8_t *buff, uint32_t *len)
+{
+  return transfer(status, buff, len);
+}
@@ -0,0 +1,56 @@
+/**
+  ******************************************************************************
+  * @file    MemorySession.h
+  * @author  SerialPortYmodem contributors
+  * @version v1.0
+  * @date    16-October-2026
+  * @brief   Header file for MemorySession.cpp module.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>Copyright &copy; 2026 SerialPortYmodem contributors</center></h2>
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#ifndef MEMORYSESSION_H
+#define MEMORYSESSION_H
+
+#include "YmodemReactor.h"
+#include "MemoryTransfer.h"
+
+/*
+ * Reactor sessions around the in-memory transmitter and receiver.
+ */
+class MemoryTransmitSession : public YmodemReactorSession, public MemoryTransmitter
+{
+public:
+  MemoryTransmitSession(int fd, uint32_t seed, uint32_t size);
+
+protected:
+  Code sessionCallback(Status status, uint8_t *buff, uint32_t *len);
+};
+
+class MemoryReceiveSession : public YmodemReactorSession, public MemoryReceiver
+{
+public:
+  MemoryReceiveSession(int fd, uint32_t options);
+
+protected:
+  Code sessionCallback(Status status, uint8_t *buff, uint32_t *len);
+};
+
+#endif // MEMORYSESSION_H
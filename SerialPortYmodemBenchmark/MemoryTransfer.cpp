@@ -0,0 +1,156 @@
+/**
+  ******************************************************************************
+  * @file    MemoryTransfer.cpp
+  * @author  SerialPortYmodem contributors
+  * @version v1.0
+  * @date    16-October-2026
+  * @brief   Generated data transmitter and verifying receiver.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>Copyright &copy; 2026 SerialPortYmodem contributors</center></h2>
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#include "MemoryTransfer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static uint8_t pattern(uint32_t seed, uint64_t offset)
+{
+  return (uint8_t)(((offset + seed) * 2654435761ULL) >> 24);
+}
+
+MemoryTransmitter::MemoryTransmitter(uint32_t seed, uint32_t size) :
+  seed(seed), size(size), count(0), sent(false), crc(0)
+{
+}
+
+uint32_t MemoryTransmitter::getCrc()
+{
+  return crc;
+}
+
+Ymodem::Code MemoryTransmitter::transfer(Ymodem::Status status, uint8_t *buff, uint32_t *len)
+{
+  switch(status)
+  {
+    case Ymodem::StatusEstablish:
+    {
+      if(sent == true)
+      {
+        return Ymodem::CodeEot;
+      }
+
+      sent = true;
+
+      sprintf((char *)buff, "session%u.bin", seed);
+      sprintf((char *)buff + strlen((char *)buff) + 1, "%u", size);
+
+      *len = YMODEM_PACKET_SIZE;
+
+      return Ymodem::CodeAck;
+    }
+
+    case Ymodem::StatusTransmit:
+    {
+      if(count == size)
+      {
+        return Ymodem::CodeEot;
+      }
+
+      if((size - count) < *len)
+      {
+        *len = (((size - count) > YMODEM_PACKET_SIZE) && (*len >= YMODEM_PACKET_1K_SIZE)) ? YMODEM_PACKET_1K_SIZE : YMODEM_PACKET_SIZE;
+      }
+
+      uint32_t length = (size - count) < *len ? (size - count) : *len;
+
+      for(uint32_t i = 0; i < length; i++)
+      {
+        buff[i] = pattern(seed, count + i);
+      }
+
+      crc    = crc32Slice8(crc, buff, length);
+      count += length;
+
+      return Ymodem::CodeAck;
+    }
+
+    case Ymodem::StatusFinish:
+    {
+      return Ymodem::CodeAck;
+    }
+
+    default:
+    {
+      return Ymodem::CodeCan;
+    }
+  }
+}
+
+/* XMODEM has no header packet, the size given here drops the padding of its last packet. */
+MemoryReceiver::MemoryReceiver(uint32_t size) :
+  size(size), count(0), crc(0)
+{
+}
+
+uint32_t MemoryReceiver::getCrc()
+{
+  return crc;
+}
+
+uint32_t MemoryReceiver::getCount()
+{
+  return count;
+}
+
+Ymodem::Code MemoryReceiver::transfer(Ymodem::Status status, uint8_t *buff, uint32_t *len)
+{
+  switch(status)
+  {
+    case Ymodem::StatusEstablish:
+    {
+      size  = (uint32_t)(strtoul((char *)buff + strlen((char *)buff) + 1, NULL, 10));
+      count = 0;
+      crc   = 0;
+
+      return Ymodem::CodeAck;
+    }
+
+    case Ymodem::StatusTransmit:
+    {
+      uint32_t length = (size - count) < *len ? (size - count) : *len;
+
+      crc    = crc32Slice8(crc, buff, length);
+      count += length;
+
+      return Ymodem::CodeAck;
+    }
+
+    case Ymodem::StatusFinish:
+    {
+      return Ymodem::CodeAck;
+    }
+
+    default:
+    {
+      return Ymodem::CodeCan;
+    }
+  }
+}
@@ -0,0 +1,71 @@
+/**
+  ******************************************************************************
+  * @file    MemoryTransfer.h
+  * @author  SerialPortYmodem contributors
+  * @version v1.0
+  * @date    16-October-2026
+  * @brief   Header file for MemoryTransfer.cpp module.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>Copyright &copy; 2026 SerialPortYmodem contributors</center></h2>
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#ifndef MEMORYTRANSFER_H
+#define MEMORYTRANSFER_H
+
+#include "Ymodem.h"
+
+/*
+ * Session callbacks that send a generated pattern and checksum what they receive, so a
+ * transfer can be verified without touching the disk.
+ */
+class MemoryTransmitter
+{
+public:
+  MemoryTransmitter(uint32_t seed, uint32_t size);
+
+  uint32_t getCrc();
+
+  Ymodem::Code transfer(Ymodem::Status status, uint8_t *buff, uint32_t *len);
+
+private:
+  uint32_t seed;
+  uint32_t size;
+  uint32_t count;
+  bool     sent;
+  uint32_t crc;
+};
+
+class MemoryReceiver
+{
+public:
+  explicit MemoryReceiver(uint32_t size = 0);
+
+  uint32_t getCrc();
+  uint32_t getCount();
+
+  Ymodem::Code transfer(Ymodem::Status status, uint8_t *buff, uint32_t *len);
+
+private:
+  uint32_t size;
+  uint32_t count;
+  uint32_t crc;
+};
+
+#endif // MEMORYTRANSFER_H
@@ -0,0 +1,378 @@
+/**
+  ******************************************************************************
+  * @file    ProtocolBenchmark.cpp
+  * @author  SerialPortYmodem contributors
+  * @version v1.0
+  * @date    17-October-2026
+  * @brief   Scripted checks of how a receiver handles damaged and unexpected input.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>Copyright &copy; 2026 SerialPortYmodem contributors</center></h2>
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#include "ProtocolBenchmark.h"
+#include "Ymodem.h"
+#include <algorithm>
+#include <deque>
+#include <vector>
+#include <stdio.h>
+#include <string.h>
+
+#define PROTOCOL_FILE_SIZE  (1024)
+
+/*
+ * A receiver fed from a script in virtual time. Each millisecond it is called until the
+ * bytes fed so far are read, as on a line faster than the receiver. Everything it writes
+ * and every byte it accepts is kept for the checks.
+ */
+class ScriptedReceiver : public Ymodem
+{
+public:
+  ScriptedReceiver() : now(0), finished(false), status(StatusEstablish)
+  {
+  }
+
+  void feed(const std::vector<uint8_t> &bytes)
+  {
+    input.insert(input.end(), bytes.begin(), bytes.end());
+  }
+
+  void run(uint32_t milliseconds)
+  {
+    for(uint32_t i = 0; (i < milliseconds) && (finished != true); i++)
+    {
+      do
+      {
+        receive();
+      } while((input.empty() != true) && (finished != true));
+
+      now = now + 1000;
+    }
+  }
+
+  Code lastResponse()
+  {
+    return (output.empty() == true) ? CodeNone : (Code)(output.back());
+  }
+
+  uint32_t countResponse(Code code)
+  {
+    return (uint32_t)(std::count(output.begin(), output.end(), (uint8_t)(code)));
+  }
+
+  void clearResponse()
+  {
+    output.clear();
+  }
+
+  bool isFinished()
+  {
+    return finished;
+  }
+
+  Status getStatus()
+  {
+    return status;
+  }
+
+  const std::vector<uint8_t> &getData()
+  {
+    return data;
+  }
+
+protected:
+  Code callback(Status status, uint8_t *buff, uint32_t *len)
+  {
+    if(status == StatusTransmit)
+    {
+      data.insert(data.end(), buff, buff + *len);
+    }
+    else if((status != StatusEstablish) && (status != StatusResume))
+    {
+      finished = true;
+    }
+
+    this->status = status;
+
+    return (status == StatusResume) ? CodeCan : CodeAck;
+  }
+
+  uint32_t read(uint8_t *buff, uint32_t len)
+  {
+    uint32_t length = (input.size() < len) ? (uint32_t)(input.size()) : len;
+
+    std::copy(input.begin(), input.begin() + length, buff);
+
+    input.erase(input.begin(), input.begin() + length);
+
+    return length;
+  }
+
+  uint32_t write(uint8_t *buff, uint32_t len)
+  {
+    output.insert(output.end(), buff, buff + len);
+
+    return len;
+  }
+
+  uint32_t tick()
+  {
+    return (uint32_t)(now / 1000);
+  }
+
+  uint64_t microTick()
+  {
+    return now;
+  }
+
+private:
+  uint64_t             now;
+  bool                 finished;
+  Status               status;
+  std::deque<uint8_t>  input;
+  std::vector<uint8_t> output;
+  std::vector<uint8_t> data;
+};
+
+static uint8_t payload(uint32_t number, uint32_t offset)
+{
+  return (uint8_t)(number * 31 + offset);
+}
+
+/**
+  * @brief  Build a 128 byte packet.
+  * @param  number: The packet number.
+  * @param  data:   The data of the packet, NULL for the pattern of @payload.
+  * @return The framed packet.
+  */
+static std::vector<uint8_t> packet(uint32_t number, const uint8_t *data)
+{
+  std::vector<uint8_t> frame(YMODEM_PACKET_SIZE + YMODEM_PACKET_HEADER + YMODEM_PACKET_TRAILER);
+
+  frame[0] = Ymodem::CodeSoh;
+  frame[1] = (uint8_t)(number);
+  frame[2] = (uint8_t)(0xFF - number);
+
+  for(uint32_t i = 0; i < YMODEM_PACKET_SIZE; i++)
+  {
+    frame[YMODEM_PACKET_HEADER + i] = (data != NULL) ? data[i] : payload(number, i);
+  }
+
+  uint16_t crc = crc16Bitwise(0, &(frame[YMODEM_PACKET_HEADER]), YMODEM_PACKET_SIZE);
+
+  frame[YMODEM_PACKET_HEADER + YMODEM_PACKET_SIZE]     = (uint8_t)(crc >> 8);
+  frame[YMODEM_PACKET_HEADER + YMODEM_PACKET_SIZE + 1] = (uint8_t)(crc >> 0);
+
+  return frame;
+}
+
+/**
+  * @brief  Take a receiver through the header and the first data packets.
+  * @param  receiver: The receiver.
+  * @param  count:    The number of data packets.
+  * @return Whether every packet was acknowledged.
+  */
+static bool protocolStart(ScriptedReceiver &receiver, uint32_t count)
+{
+  uint8_t header[YMODEM_PACKET_SIZE] = {0};
+
+  sprintf((char *)header, "protocol.bin");
+  sprintf((char *)header + strlen((char *)header) + 1, "%u", PROTOCOL_FILE_SIZE);
+
+  receiver.run(10);
+  receiver.feed(packet(0, header));
+  receiver.run(10);
+
+  for(uint32_t i = 1; i <= count; i++)
+  {
+    receiver.feed(packet(i, NULL));
+    receiver.run(10);
+  }
+
+  bool result = (receiver.countResponse(Ymodem::CodeAck) == count + 1) && (receiver.lastResponse() == Ymodem::CodeAck);
+
+  receiver.clearResponse();
+
+  return result;
+}
+
+/**
+  * @brief  Check the data a receiver has accepted.
+  * @param  receiver: The receiver.
+  * @param  count:    The number of data packets sent in sequence.
+  * @return Whether the data are those of the packets, in order and once each.
+  */
+static bool protocolData(ScriptedReceiver &receiver, uint32_t count)
+{
+  const std::vector<uint8_t> &data = receiver.getData();
+
+  if(data.size() != count * YMODEM_PACKET_SIZE)
+  {
+    return false;
+  }
+
+  for(uint32_t i = 0; i < data.size(); i++)
+  {
+    if(data[i] != payload(i / YMODEM_PACKET_SIZE + 1, i % YMODEM_PACKET_SIZE))
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/* A single CAN between packets may be noise and must not end the transfer. */
+static bool protocolSingleCan()
+{
+  ScriptedReceiver receiver;
+
+  bool started = protocolStart(receiver, 1);
+
+  receiver.feed(std::vector<uint8_t>(1, Ymodem::CodeCan));
+  receiver.feed(packet(2, NULL));
+  receiver.run(20);
+
+  return (started == true) && (receiver.isFinished() != true) &&
+         (receiver.lastResponse() == Ymodem::CodeAck) && (protocolData(receiver, 2) == true);
+}
+
+/* Two CANs in a row abort the transfer. */
+static bool protocolDoubleCan()
+{
+  ScriptedReceiver receiver;
+
+  bool started = protocolStart(receiver, 1);
+
+  receiver.feed(std::vector<uint8_t>(2, Ymodem::CodeCan));
+  receiver.run(20);
+
+  return (started == true) && (receiver.getStatus() == Ymodem::StatusAbort);
+}
+
+/*
+ * A packet whose number and complement do not match is dropped and NAKed once the line is
+ * idle. Packet 5 is used, neither its number nor the damaged complement is a start code.
+ */
+static bool protocolDamagedHeader()
+{
+  ScriptedReceiver receiver;
+
+  bool                 started = protocolStart(receiver, 4);
+  std::vector<uint8_t> damaged = packet(5, NULL);
+
+  damaged[2] = damaged[2] ^ 0x10;
+
+  receiver.feed(damaged);
+  receiver.run(50);
+
+  bool nak = (receiver.countResponse(Ymodem::CodeNak) == 1) && (receiver.lastResponse() == Ymodem::CodeNak);
+
+  receiver.feed(packet(5, NULL));
+  receiver.run(20);
+
+  return (started == true) && (nak == true) && (receiver.isFinished() != true) &&
+         (receiver.lastResponse() == Ymodem::CodeAck) && (protocolData(receiver, 5) == true);
+}
+
+/*
+ * A packet that lost its start code is discarded, the CAN, CAN and EOT in its data must
+ * not be taken for codes. Packet 5 is used, its number is not a start code.
+ */
+static bool protocolLostStart()
+{
+  ScriptedReceiver receiver;
+
+  bool                 started = protocolStart(receiver, 4);
+  uint8_t              data[YMODEM_PACKET_SIZE];
+  std::vector<uint8_t> lost;
+
+  for(uint32_t i = 0; i < YMODEM_PACKET_SIZE; i++)
+  {
+    data[i] = payload(5, i);
+  }
+
+  data[0] = Ymodem::CodeCan;
+  data[1] = Ymodem::CodeCan;
+  data[2] = Ymodem::CodeEot;
+
+  lost = packet(5, data);
+  lost.erase(lost.begin());
+
+  receiver.feed(lost);
+  receiver.run(50);
+
+  bool nak = (receiver.countResponse(Ymodem::CodeNak) == 1) && (receiver.lastResponse() == Ymodem::CodeNak);
+
+  receiver.feed(packet(5, NULL));
+  receiver.run(20);
+
+  return (started == true) && (nak == true) && (receiver.isFinished() != true) &&
+         (receiver.lastResponse() == Ymodem::CodeAck) && (protocolData(receiver, 5) == true);
+}
+
+/* An intact packet ahead of sequence means a packet was skipped, the transfer is cancelled. */
+static bool protocolAhead()
+{
+  ScriptedReceiver receiver;
+
+  bool started = protocolStart(receiver, 1);
+
+  receiver.feed(packet(3, NULL));
+  receiver.run(20);
+
+  return (started == true) && (receiver.getStatus() == Ymodem::StatusError) &&
+         (receiver.lastResponse() == Ymodem::CodeCan) && (protocolData(receiver, 1) == true);
+}
+
+/**
+  * @brief  Run the scripted receiver checks.
+  * @note   Each check starts a new receiver and prints one line with its result.
+  * @return 0 when every check passes, 1 otherwise.
+  */
+int protocolBenchmark()
+{
+  struct
+  {
+    const char *name;
+    bool      (*check)();
+  } checks[] =
+  {
+    {"single-can",     protocolSingleCan},
+    {"double-can",     protocolDoubleCan},
+    {"damaged-header", protocolDamagedHeader},
+    {"lost-start",     protocolLostStart},
+    {"ahead",          protocolAhead}
+  };
+
+  int result = 0;
+
+  printf("%-16s %s\n", "check", "result");
+
+  for(uint32_t i = 0; i < sizeof(checks) / sizeof(checks[0]); i++)
+  {
+    bool pass = checks[i].check();
+
+    printf("%-16s %s\n", checks[i].name, (pass == true) ? "ok" : "FAIL");
+
+    result |= (pass == true) ? 0 : 1;
+  }
+
+  return result;
+}
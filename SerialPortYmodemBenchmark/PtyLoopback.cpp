@@ -0,0 +1,294 @@
+/**
+  ******************************************************************************
+  * @file    PtyLoopback.cpp
+  * @author  SerialPortYmodem contributors
+  * @version v1.0
+  * @date    16-October-2026
+  * @brief   Pseudo terminal pairs joined as serial loopbacks.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>Copyright &copy; 2026 SerialPortYmodem contributors</center></h2>
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#include "PtyLoopback.h"
+#include <chrono>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <unistd.h>
+
+/* Line time a paced direction gathers before it is relayed, in nanoseconds. */
+#define PTY_LOOPBACK_SLICE_TIME (1000000ULL)
+
+static uint64_t now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+         std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+PtyLoopback::PtyLoopback() :
+  baudrate(0),
+  stop(false)
+{
+  wake[0] = -1;
+  wake[1] = -1;
+}
+
+PtyLoopback::~PtyLoopback()
+{
+  close();
+}
+
+bool PtyLoopback::open(uint32_t count, uint32_t baudrate)
+{
+  close();
+
+  this->baudrate = baudrate;
+
+  sides.resize(count * 2);
+
+  for(uint32_t i = 0; i < sides.size(); i++)
+  {
+    sides[i].master = -1;
+    sides[i].slave  = -1;
+  }
+
+  for(uint32_t i = 0; i < sides.size(); i++)
+  {
+    if(openSide(sides[i]) != true)
+    {
+      close();
+
+      return false;
+    }
+  }
+
+  if(pipe(wake) != 0)
+  {
+    close();
+
+    return false;
+  }
+
+  stop  = false;
+  relay = std::thread(&PtyLoopback::run, this);
+
+  return true;
+}
+
+void PtyLoopback::close()
+{
+  if(relay.joinable() == true)
+  {
+    stop = true;
+
+    if(::write(wake[1], "", 1) != 1)
+    {
+      abort();
+    }
+
+    relay.join();
+  }
+
+  for(uint32_t i = 0; i < sides.size(); i++)
+  {
+    if(sides[i].master >= 0)
+    {
+      ::close(sides[i].master);
+    }
+
+    if(sides[i].slave >= 0)
+    {
+      ::close(sides[i].slave);
+    }
+  }
+
+  for(uint32_t i = 0; i < 2; i++)
+  {
+    if(wake[i] >= 0)
+    {
+      ::close(wake[i]);
+
+      wake[i] = -1;
+    }
+  }
+
+  sides.clear();
+}
+
+uint32_t PtyLoopback::getCount()
+{
+  return sides.size() / 2;
+}
+
+std::string PtyLoopback::getPortName(uint32_t link, uint32_t side)
+{
+  return sides[link * 2 + (side & 1)].name;
+}
+
+/**
+  * @brief  Open a pseudo-terminal and keep its slave open in raw mode.
+  * @note   Holding the slave open keeps the master readable while the port is closed
+  *         and stops the line discipline from echoing before the port is configured.
+  * @param  side: The side to open.
+  * @return Success or failure.
+  */
+bool PtyLoopback::openSide(Side &side)
+{
+  struct termios tio;
+
+  side.master = posix_openpt(O_RDWR | O_NOCTTY);
+  side.offset = 0;
+  side.length = 0;
+  side.time   = 0;
+
+  if((side.master < 0) || (grantpt(side.master) != 0) || (unlockpt(side.master) != 0) ||
+     (ptsname(side.master) == NULL))
+  {
+    return false;
+  }
+
+  side.name  = ptsname(side.master);
+  side.slave = ::open(side.name.c_str(), O_RDWR | O_NOCTTY);
+
+  if((side.slave < 0) || (tcgetattr(side.slave, &tio) != 0))
+  {
+    return false;
+  }
+
+  cfmakeraw(&tio);
+
+  if(tcsetattr(side.slave, TCSANOW, &tio) != 0)
+  {
+    return false;
+  }
+
+  return fcntl(side.master, F_SETFL, fcntl(side.master, F_GETFL) | O_NONBLOCK) == 0;
+}
+
+/**
+  * @brief  Relay bytes between the masters of each link.
+  * @note   A side whose buffer is still pending for its peer is not read again, so a slow
+  *         reader applies back pressure to its own link only.
+  * @note   A paced side keeps the time its line finishes the bytes relayed so far and
+  *         relays a byte once the line has started sending it. While bytes are pending
+  *         the poll sleeps until about a millisecond of line time is due, and a late
+  *         wakeup only relays more at once instead of losing line time.
+  */
+void PtyLoopback::run()
+{
+  std::vector<struct pollfd> fds(sides.size() + 1);
+
+  uint64_t byteTime  = (baudrate != 0) ? (10000000000ULL / baudrate) : 0;
+  uint64_t sliceSize = (baudrate != 0) ? (PTY_LOOPBACK_SLICE_TIME / byteTime + 1) : 0;
+
+  while(stop != true)
+  {
+    uint64_t time    = now();
+    int      timeout = -1;
+
+    for(uint32_t i = 0; i < sides.size(); i++)
+    {
+      Side &side = sides[i];
+      Side &peer = sides[i ^ 1];
+
+      fds[i].fd      = side.master;
+      fds[i].events  = (side.offset == side.length) ? POLLIN : 0;
+      fds[i].revents = 0;
+
+      if(peer.offset != peer.length)
+      {
+        uint64_t slice = (peer.length - peer.offset < sliceSize) ? (peer.length - peer.offset) : sliceSize;
+        uint64_t due   = peer.time + (slice - 1) * byteTime;
+
+        if((baudrate == 0) || (due <= time))
+        {
+          fds[i].events |= POLLOUT;
+        }
+        else
+        {
+          int wait = (int)((due - time + 999999) / 1000000);
+
+          timeout = ((timeout < 0) || (wait < timeout)) ? wait : timeout;
+        }
+      }
+    }
+
+    fds[sides.size()].fd      = wake[0];
+    fds[sides.size()].events  = POLLIN;
+    fds[sides.size()].revents = 0;
+
+    if((poll(fds.data(), fds.size(), timeout) < 0) && (errno != EINTR))
+    {
+      return;
+    }
+
+    time = now();
+
+    for(uint32_t i = 0; i < sides.size(); i++)
+    {
+      Side &side = sides[i];
+      Side &peer = sides[i ^ 1];
+
+      if((side.offset == side.length) && ((fds[i].revents & POLLIN) != 0))
+      {
+        ssize_t number = ::read(side.master, side.buff, sizeof(side.buff));
+
+        if(number > 0)
+        {
+          side.offset = 0;
+          side.length = number;
+          side.time   = (side.time > time) ? side.time : time;
+        }
+      }
+
+      if(side.offset != side.length)
+      {
+        uint32_t length = side.length - side.offset;
+
+        if(baudrate != 0)
+        {
+          uint64_t quota = (side.time <= time) ? ((time - side.time) / byteTime + 1) : 0;
+
+          length = (quota < length) ? (uint32_t)(quota) : length;
+        }
+
+        ssize_t number = (length != 0) ? ::write(peer.master, side.buff + side.offset, length) : 0;
+
+        if(number > 0)
+        {
+          side.offset += number;
+
+          if(baudrate != 0)
+          {
+            side.time += number * byteTime;
+          }
+        }
+
+        if(side.offset == side.length)
+        {
+          side.offset = 0;
+          side.length = 0;
+        }
+      }
+    }
+  }
+}
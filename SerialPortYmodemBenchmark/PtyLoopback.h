@@ -0,0 +1,78 @@
+/**
+  ******************************************************************************
+  * @file    PtyLoopback.h
+  * @author  SerialPortYmodem contributors
+  * @version v1.0
+  * @date    16-October-2026
+  * @brief   Header file for PtyLoopback.cpp module.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>Copyright &copy; 2026 SerialPortYmodem contributors</center></h2>
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#ifndef PTYLOOPBACK_H
+#define PTYLOOPBACK_H
+
+#include <stdint.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+ * Connects pairs of pseudo-terminals back to back: bytes written to the slave of one
+ * side are relayed to the slave of the other side, so each link looks like a null-modem
+ * cable between two serial ports. With a baud rate set, each direction is paced to the
+ * raw line rate of an 8N1 UART (ten bits per byte).
+ */
+class PtyLoopback
+{
+public:
+  PtyLoopback();
+  ~PtyLoopback();
+
+  bool open(uint32_t count, uint32_t baudrate = 0);
+  void close();
+
+  uint32_t getCount();
+  std::string getPortName(uint32_t link, uint32_t side);
+
+private:
+  struct Side
+  {
+    int         master;
+    int         slave;
+    std::string name;
+    uint8_t     buff[4096];
+    uint32_t    offset;
+    uint32_t    length;
+    uint64_t    time;
+  };
+
+  bool openSide(Side &side);
+  void run();
+
+  uint32_t           baudrate;
+  std::vector<Side>  sides;
+  std::thread        relay;
+  std::atomic<bool>  stop;
+  int                wake[2];
+};
+
+#endif // PTYLOOPBACK_H
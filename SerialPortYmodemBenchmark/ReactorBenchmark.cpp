@@ -0,0 +1,148 @@
+/**
+  ******************************************************************************
+  * @file    ReactorBenchmark.cpp
+  * @author  SerialPortYmodem contributors
+  * @version v1.0
+  * @date    16-October-2026
+  * @brief   Reactor benchmark running many sessions over pty loopbacks.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>Copyright &copy; 2026 SerialPortYmodem contributors</center></h2>
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#include "ReactorBenchmark.h"
+#include "PtyLoopback.h"
+#include "MemorySession.h"
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/resource.h>
+
+static const char *statusName(Ymodem::Status status)
+{
+  switch(status)
+  {
+    case Ymodem::StatusEstablish: return "establish";
+    case Ymodem::StatusTransmit:  return "transmit";
+    case Ymodem::StatusFinish:    return "finish";
+    case Ymodem::StatusAbort:     return "abort";
+    case Ymodem::StatusTimeout:   return "timeout";
+    default:                      return "error";
+  }
+}
+
+static void printStats(const char *name, const char *status, const YmodemReactorStats &stats)
+{
+  printf("%-10s %-10s %10llu %10llu %12.1f %12.1f %12.3f %12llu %12llu\n", name, status,
+         (unsigned long long)(stats.wakeups), (unsigned long long)(stats.timeouts),
+         stats.wakeups != 0 ? stats.latencyTotal / 1000.0 / stats.wakeups : 0.0, stats.latencyMax / 1000.0,
+         stats.cpuTime / 1000000.0, (unsigned long long)(stats.bytesRead), (unsigned long long)(stats.bytesWritten));
+}
+
+int reactorBenchmark(uint32_t sessions, uint32_t size, uint32_t options)
+{
+  struct rlimit limit;
+
+  /* Each link takes two pseudo-terminals with a master and two slave descriptors each. */
+  if(getrlimit(RLIMIT_NOFILE, &limit) == 0)
+  {
+    limit.rlim_cur = limit.rlim_max;
+
+    setrlimit(RLIMIT_NOFILE, &limit);
+  }
+
+  PtyLoopback   loopback;
+  YmodemReactor reactor;
+
+  std::vector<std::unique_ptr<MemoryTransmitSession>> transmitters;
+  std::vector<std::unique_ptr<MemoryReceiveSession>>  receivers;
+
+  if(loopback.open(sessions) != true)
+  {
+    printf("failed to create %u pty links\n", sessions);
+
+    return 1;
+  }
+
+  for(uint32_t i = 0; i < sessions; i++)
+  {
+    int transmit = YmodemReactorSession::openPort(loopback.getPortName(i, 0).c_str(), 115200);
+    int receive  = YmodemReactorSession::openPort(loopback.getPortName(i, 1).c_str(), 115200);
+
+    if((transmit < 0) || (receive < 0))
+    {
+      printf("failed to open pty link %u\n", i);
+
+      return 1;
+    }
+
+    transmitters.emplace_back(new MemoryTransmitSession(transmit, i, size));
+    receivers.emplace_back(new MemoryReceiveSession(receive, options));
+
+    reactor.add(transmitters.back().get());
+    reactor.add(receivers.back().get());
+  }
+
+  uint64_t start = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch()).count();
+
+  reactor.run();
+
+  uint64_t stop = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                  std::chrono::steady_clock::now().time_since_epoch()).count();
+
+  int result = 0;
+
+  printf("%-10s %-10s %10s %10s %12s %12s %12s %12s %12s\n", "session", "status", "wakeups", "timeouts",
+         "latency-us", "max-us", "cpu-ms", "read", "written");
+
+  for(uint32_t i = 0; i < sessions; i++)
+  {
+    char name[32];
+
+    bool match = (receivers[i]->getCount() == size) && (receivers[i]->getCrc() == transmitters[i]->getCrc());
+
+    sprintf(name, "tx%u", i);
+    printStats(name, statusName(transmitters[i]->getStatus()), transmitters[i]->getStats());
+
+    sprintf(name, "rx%u", i);
+    printStats(name, match == true ? statusName(receivers[i]->getStatus()) : "mismatch", receivers[i]->getStats());
+
+    if((transmitters[i]->getStatus() != Ymodem::StatusFinish) || (receivers[i]->getStatus() != Ymodem::StatusFinish) ||
+       (match != true))
+    {
+      result = 1;
+    }
+
+    close(transmitters[i]->getFd());
+    close(receivers[i]->getFd());
+  }
+
+  double seconds = (stop - start) / 1000000000.0;
+
+  printStats("total", result == 0 ? "finish" : "error", reactor.getStats());
+
+  printf("sessions %u, size %u, %.3f s, %.0f bytes/s, reactor cpu %.1f%%, idle %.1f%%\n", sessions * 2, size, seconds,
+         (double)(size) * sessions / seconds, reactor.getStats().cpuTime / 10000000.0 / seconds,
+         reactor.getIdleTime() / 10000000.0 / seconds);
+
+  return result;
+}
@@ -0,0 +1,350 @@
+/**
+  ******************************************************************************
+  * @file    RingBenchmark.cpp
+  * @author  SerialPortYmodem contributors
+  * @version v1.0
+  * @date    17-October-2026
+  * @brief   Byte ring and serial I/O thread benchmark.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>Copyright &copy; 2026 SerialPortYmodem contributors</center></h2>
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#include "RingBenchmark.h"
+#include "PtyLoopback.h"
+#include "MemoryTransfer.h"
+#include "YmodemReactor.h"
+#include "YmodemSerialThread.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <stdio.h>
+#include <unistd.h>
+
+#define RING_RUN_TIME   (1000)
+
+/*
+ * Transport of a benchmark session: the in-memory transfer supplies the callback, the
+ * serial thread the bytes. It counts what the session writes, so the engine loop knows
+ * whether a step made progress.
+ */
+template<class Transfer>
+class RingTransport : public YmodemSerialTransport
+{
+public:
+  RingTransport() : transfer(NULL), finished(false), status(YmodemBase::StatusEstablish), written(0)
+  {
+  }
+
+  void setTransfer(Transfer *transfer)
+  {
+    this->transfer = transfer;
+  }
+
+  bool isFinished()
+  {
+    return finished;
+  }
+
+  YmodemBase::Status getStatus()
+  {
+    return status;
+  }
+
+  uint64_t getWritten()
+  {
+    return written;
+  }
+
+protected:
+  YmodemBase::Code callback(YmodemBase::Status status, uint8_t *buff, uint32_t *len)
+  {
+    YmodemBase::Code code = transfer->transfer(status, buff, len);
+
+    if((status == YmodemBase::StatusEstablish) || (status == YmodemBase::StatusTransmit))
+    {
+      finished     = code == YmodemBase::CodeCan;
+      this->status = (finished == true) ? YmodemBase::StatusError : status;
+    }
+    else if(status != YmodemBase::StatusResume)
+    {
+      finished     = true;
+      this->status = status;
+    }
+
+    return code;
+  }
+
+  uint32_t write(uint8_t *buff, uint32_t len)
+  {
+    written += len;
+
+    return YmodemSerialTransport::write(buff, len);
+  }
+
+private:
+  Transfer           *transfer;
+  bool                finished;
+  YmodemBase::Status  status;
+  uint64_t            written;
+};
+
+typedef YmodemCore<YMODEM_PACKET_EXT_SIZE, YmodemCrc16, true, RingTransport<MemoryTransmitter> > RingTransmitSession;
+typedef YmodemCore<YMODEM_PACKET_EXT_SIZE, YmodemCrc16, true, RingTransport<MemoryReceiver> >    RingReceiveSession;
+
+static const char *statusName(Ymodem::Status status)
+{
+  switch(status)
+  {
+    case Ymodem::StatusEstablish: return "establish";
+    case Ymodem::StatusTransmit:  return "transmit";
+    case Ymodem::StatusFinish:    return "finish";
+    case Ymodem::StatusAbort:     return "abort";
+    case Ymodem::StatusTimeout:   return "timeout";
+    default:                      return "error";
+  }
+}
+
+/**
+  * @brief  Push a counting pattern through one ring between two threads.
+  * @note   A side yields when the ring is full or empty, so the run also works when
+  *         both threads share a core.
+  * @param  chunk: The length of each write and read.
+  * @param  milliseconds: The time to run.
+  * @param  match: Set when every byte read matched the pattern.
+  * @return The sustained rate in MB/s.
+  */
+static double ringRun(uint32_t chunk, uint32_t milliseconds, bool *match)
+{
+  static uint8_t pattern[256 + YMODEM_PACKET_EXT_SIZE];
+
+  YmodemRing<YMODEM_SERIAL_RING_SIZE> ring;
+
+  std::vector<uint8_t> buff(chunk);
+  std::atomic<bool>    stop(false);
+
+  for(uint32_t i = 0; i < sizeof(pattern); i++)
+  {
+    pattern[i] = (uint8_t)(i);
+  }
+
+  std::thread producer([&]()
+  {
+    uint64_t position = 0;
+
+    while(stop.load(std::memory_order_relaxed) != true)
+    {
+      uint32_t length = ring.write(&(pattern[position & 0xFF]), chunk);
+
+      if(length == 0)
+      {
+        std::this_thread::yield();
+      }
+
+      position += length;
+    }
+  });
+
+  uint64_t position = 0;
+  uint8_t  error    = 0;
+  auto     start    = std::chrono::steady_clock::now();
+  auto     deadline = start + std::chrono::milliseconds(milliseconds);
+  auto     now      = start;
+
+  do
+  {
+    for(int i = 0; i < 64; i++)
+    {
+      uint32_t length = ring.read(buff.data(), chunk);
+
+      if(length == 0)
+      {
+        std::this_thread::yield();
+      }
+
+      for(uint32_t j = 0; j < length; j++)
+      {
+        error |= buff[j] ^ (uint8_t)(position + j);
+      }
+
+      position += length;
+    }
+
+    now = std::chrono::steady_clock::now();
+  }
+  while(now < deadline);
+
+  stop = true;
+
+  producer.join();
+
+  *match = error == 0;
+
+  return position / std::chrono::duration<double>(now - start).count() / 1000000.0;
+}
+
+/**
+  * @brief  Run a session until it finishes.
+  * @note   With a tick time the session sleeps between ticks and each tick handles
+  *         what arrived since the last one, so the port is drained by the serial thread
+  *         alone in between.
+  * @param  session: The session.
+  * @param  port: The serial thread of the session.
+  * @param  transmit: Step the session as transmitter.
+  * @param  tickTime: The time between ticks in milliseconds, 0 to step on events.
+  * @return None.
+  */
+template<class Session>
+static void sessionRun(Session *session, YmodemSerialThread *port, bool transmit, uint32_t tickTime)
+{
+  while((session->isFinished() != true) && (port->isRunning() == true))
+  {
+    uint64_t written = 0;
+
+    do
+    {
+      written = session->getWritten();
+
+      if(transmit == true)
+      {
+        session->transmit();
+      }
+      else
+      {
+        session->receive();
+      }
+    }
+    while((tickTime > 0) && (session->isFinished() != true) &&
+          ((session->getWritten() != written) || (port->wait(0) == true)));
+
+    if(tickTime > 0)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(tickTime));
+    }
+    else if(session->getWritten() == written)
+    {
+      port->wait(session->getTimeToDeadline());
+    }
+  }
+}
+
+/**
+  * @brief  Transfer a payload over a pty link through two serial threads.
+  * @param  size: The payload size in bytes.
+  * @param  tickTime: The time between protocol steps in milliseconds, 0 to step on events.
+  * @param  options: The protocol options requested by the receiver.
+  * @param  baudrate: The line rate the link is paced to, 0 for an unpaced link.
+  * @return 0 on a verified transfer, 1 otherwise.
+  */
+static int transferRun(uint32_t size, uint32_t tickTime, uint32_t options, uint32_t baudrate)
+{
+  PtyLoopback loopback;
+
+  if(loopback.open(1, baudrate) != true)
+  {
+    printf("failed to create a pty link\n");
+
+    return 1;
+  }
+
+  int transmit = YmodemReactorSession::openPort(loopback.getPortName(0, 0).c_str(), (baudrate != 0) ? baudrate : 115200);
+  int receive  = YmodemReactorSession::openPort(loopback.getPortName(0, 1).c_str(), (baudrate != 0) ? baudrate : 115200);
+
+  if((transmit < 0) || (receive < 0))
+  {
+    printf("failed to open the pty link\n");
+
+    return 1;
+  }
+
+  MemoryTransmitter   transmitter(0, size);
+  MemoryReceiver      receiver;
+  RingTransmitSession transmitSession;
+  RingReceiveSession  receiveSession;
+  YmodemSerialThread  transmitPort;
+  YmodemSerialThread  receivePort;
+
+  transmitSession.setTransfer(&transmitter);
+  transmitSession.setPort(&transmitPort);
+  receiveSession.setTransfer(&receiver);
+  receiveSession.setPort(&receivePort);
+  receiveSession.setOptions(options);
+
+  if((transmitPort.start(transmit) != true) || (receivePort.start(receive) != true))
+  {
+    printf("failed to start the serial threads\n");
+
+    return 1;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+
+  std::thread transmitThread(sessionRun<RingTransmitSession>, &transmitSession, &transmitPort, true, tickTime);
+  std::thread receiveThread(sessionRun<RingReceiveSession>, &receiveSession, &receivePort, false, tickTime);
+
+  transmitThread.join();
+  receiveThread.join();
+
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  transmitPort.stop();
+  receivePort.stop();
+
+  close(transmit);
+  close(receive);
+
+  bool match  = (receiver.getCount() == size) && (receiver.getCrc() == transmitter.getCrc());
+  bool finish = (transmitSession.getStatus() == Ymodem::StatusFinish) && (receiveSession.getStatus() == Ymodem::StatusFinish);
+
+  const YmodemSerialStats &stats = receivePort.getStats();
+
+  printf("%10u %6u %7u %8u %-10s %10.3f %10.2f %10u %8llu %10llu %10s\n", size, tickTime, options, baudrate,
+         statusName((transmitSession.getStatus() != Ymodem::StatusFinish) ? transmitSession.getStatus() : receiveSession.getStatus()),
+         seconds, size / seconds / 1000000.0, stats.rxPeak, (unsigned long long)(stats.rxFull),
+         (unsigned long long)(stats.wakeups), (match == true) ? "ok" : "MISMATCH");
+
+  return ((finish == true) && (match == true)) ? 0 : 1;
+}
+
+int ringBenchmark(uint32_t size, uint32_t tickTime, uint32_t options, uint32_t baudrate)
+{
+  static const uint32_t chunks[] = {1, 16, YMODEM_PACKET_SIZE + YMODEM_PACKET_OVERHEAD, 4096};
+
+  int result = 0;
+
+  printf("%-10s %10s %12s %10s\n", "ring", "chunk", "MB/s", "data");
+
+  for(uint32_t chunk : chunks)
+  {
+    bool   match = false;
+    double rate  = ringRun(chunk, RING_RUN_TIME, &match);
+
+    printf("%-10s %10u %12.1f %10s\n", "spsc", chunk, rate, (match == true) ? "ok" : "MISMATCH");
+
+    result |= (match == true) ? 0 : 1;
+  }
+
+  printf("\n%10s %6s %7s %8s %-10s %10s %10s %10s %8s %10s %10s\n", "size", "tick", "options", "baudrate",
+         "status", "seconds", "MB/s", "rx_peak", "rx_full", "wakeups", "data");
+
+  result |= transferRun(size, tickTime, options, baudrate);
+
+  return result;
+}
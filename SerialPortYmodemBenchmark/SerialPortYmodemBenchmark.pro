@@ -0,0 +1,83 @@
+#-------------------------------------------------
+#
+# SerialPortYmodem benchmarks.
+#
+#-------------------------------------------------
+
+QT       -= gui
+QT       += serialport
+
+CONFIG   += console c++11
+CONFIG   -= app_bundle
+
+TARGET = SerialPortYmodemBenchmark
+TEMPLATE = app
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+INCLUDEPATH += ../SerialPortYmodem
+
+SOURCES += main.cpp \
+    Crc16Benchmark.cpp \
+    FaultBenchmark.cpp \
+    MemoryTransfer.cpp \
+    ProtocolBenchmark.cpp \
+    SimulatedLink.cpp \
+    VariantBenchmark.cpp \
+    ../SerialPortYmodem/Ymodem.cpp \
+    ../SerialPortYmodem/Crc16.cpp \
+    ../SerialPortYmodem/Crc32.cpp
+
+HEADERS  += Crc16Benchmark.h \
+    FaultBenchmark.h \
+    MemoryTransfer.h \
+    ProtocolBenchmark.h \
+    SimulatedLink.h \
+    VariantBenchmark.h \
+    ../SerialPortYmodem/Ymodem.h \
+    ../SerialPortYmodem/YmodemCore.h \
+    ../SerialPortYmodem/Crc16.h \
+    ../SerialPortYmodem/Crc32.h
+
+unix {
+    DEFINES += YMODEM_BENCHMARK_PTY
+
+    SOURCES += PtyLoopback.cpp \
+        TransferManagerBenchmark.cpp \
+        ../SerialPortYmodem/YmodemFileSource.cpp \
+        ../SerialPortYmodem/YmodemFileSink.cpp \
+        ../SerialPortYmodem/YmodemCompress.cpp \
+        ../SerialPortYmodem/YmodemDelta.cpp \
+        ../SerialPortYmodem/YmodemFileTransmit.cpp \
+        ../SerialPortYmodem/YmodemFileReceive.cpp \
+        ../SerialPortYmodem/YmodemTransferManager.cpp
+
+    HEADERS += PtyLoopback.h \
+        TransferManagerBenchmark.h \
+        ../SerialPortYmodem/YmodemFileSource.h \
+        ../SerialPortYmodem/YmodemFileSink.h \
+        ../SerialPortYmodem/YmodemCompress.h \
+        ../SerialPortYmodem/YmodemDelta.h \
+        ../SerialPortYmodem/YmodemFileTransmit.h \
+        ../SerialPortYmodem/YmodemFileReceive.h \
+        ../SerialPortYmodem/YmodemTransferManager.h
+}
+
+linux {
+    DEFINES += YMODEM_BENCHMARK_REACTOR
+
+    SOURCES += MemorySession.cpp \
+        ReactorBenchmark.cpp \
+        RingBenchmark.cpp \
+        ThroughputBenchmark.cpp \
+        ../SerialPortYmodem/YmodemReactor.cpp \
+        ../SerialPortYmodem/YmodemSerialThread.cpp
+
+    HEADERS += MemorySession.h \
+        ReactorBenchmark.h \
+        RingBenchmark.h \
+        ThroughputBenchmark.h \
+        ../SerialPortYmodem/YmodemReactor.h \
+        ../SerialPortYmodem/YmodemRing.h \
+        ../SerialPortYmodem/YmodemSerialThread.h
+}
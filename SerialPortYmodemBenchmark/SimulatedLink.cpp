@@ -0,0 +1,354 @@
+/**
+  ******************************************************************************
+  * @file    SimulatedLink.cpp
+  * @author  SerialPortYmodem contributors
+  * @version v1.0
+  * @date    16-October-2026
+  * @brief   Simulated serial link with fault injection in virtual time.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>Copyright &copy; 2026 SerialPortYmodem contributors</center></h2>
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#include "SimulatedLink.h"
+#include <string.h>
+
+SimulatedChannel::SimulatedChannel() :
+  lineTime(0),
+  burstRemain(0)
+{
+  memset(&faults, 0, sizeof(faults));
+  memset(&stats, 0, sizeof(stats));
+
+  faults.baudrate = 115200;
+}
+
+void SimulatedChannel::setFaults(const SimulatedFaults &faults)
+{
+  this->faults = faults;
+
+  if(this->faults.baudrate == 0)
+  {
+    this->faults.baudrate = 115200;
+  }
+}
+
+void SimulatedChannel::setSeed(uint32_t seed)
+{
+  random.seed(seed);
+}
+
+/**
+  * @brief  Send bytes down the line.
+  * @note   Each byte leaves once the line has sent the bytes before it and arrives one
+  *         latency later. A fault is recorded at the arrival time of the byte it hits.
+  * @param  now:  The current time in nanoseconds.
+  * @param  buff: The bytes to send.
+  * @param  len:  The number of bytes.
+  */
+void SimulatedChannel::write(uint64_t now, const uint8_t *buff, uint32_t len)
+{
+  uint64_t byteTime = 10000000000ULL / faults.baudrate;
+
+  for(uint32_t i = 0; i < len; i++)
+  {
+    uint8_t value = buff[i];
+    bool    fault = false;
+
+    lineTime = ((lineTime > now) ? lineTime : now) + byteTime;
+
+    stats.bytesWritten++;
+
+    if((burstRemain == 0) && (chance(faults.burstRate) == true))
+    {
+      burstRemain = faults.burstLength;
+
+      stats.bursts++;
+    }
+
+    if(burstRemain > 0)
+    {
+      burstRemain--;
+
+      value = (uint8_t)(random());
+      fault = fault || (value != buff[i]);
+    }
+
+    if(faults.bitErrorRate > 0)
+    {
+      for(uint32_t bit = 0; bit < 8; bit++)
+      {
+        if(chance(faults.bitErrorRate) == true)
+        {
+          value ^= 1 << bit;
+          fault  = true;
+
+          stats.bitsFlipped++;
+        }
+      }
+    }
+
+    uint64_t arrival = lineTime + faults.latency * 1000ULL;
+
+    if(chance(faults.dropRate) == true)
+    {
+      faultTimes.push_back(arrival);
+
+      stats.bytesDropped++;
+
+      continue;
+    }
+
+    if(fault == true)
+    {
+      faultTimes.push_back(arrival);
+    }
+
+    deliver(arrival, value);
+
+    if(chance(faults.duplicateRate) == true)
+    {
+      faultTimes.push_back(arrival);
+      deliver(arrival, value);
+
+      stats.bytesDuplicated++;
+    }
+  }
+}
+
+/**
+  * @brief  Receive the bytes that have arrived.
+  * @param  now:  The current time in nanoseconds.
+  * @param  buff: The buffer to read into.
+  * @param  len:  The maximum length to read.
+  * @return The length read.
+  */
+uint32_t SimulatedChannel::read(uint64_t now, uint8_t *buff, uint32_t len)
+{
+  uint32_t size = 0;
+
+  while((size < len) && (queue.empty() != true) && (queue.front().arrival <= now))
+  {
+    buff[size++] = queue.front().value;
+
+    queue.pop_front();
+  }
+
+  return size;
+}
+
+uint32_t SimulatedChannel::available(uint64_t now)
+{
+  uint32_t size = 0;
+
+  for(std::deque<Byte>::iterator i = queue.begin(); (i != queue.end()) && (i->arrival <= now); ++i)
+  {
+    size++;
+  }
+
+  return size;
+}
+
+/**
+  * @brief  Get the number of bytes still waiting to leave, like a UART transmit buffer.
+  * @param  now: The current time in nanoseconds.
+  * @return The number of bytes.
+  */
+uint32_t SimulatedChannel::backlog(uint64_t now)
+{
+  return (lineTime > now) ? (uint32_t)((lineTime - now) / (10000000000ULL / faults.baudrate)) : 0;
+}
+
+uint64_t SimulatedChannel::getNextArrival(uint64_t now)
+{
+  for(std::deque<Byte>::iterator i = queue.begin(); i != queue.end(); ++i)
+  {
+    if(i->arrival > now)
+    {
+      return i->arrival;
+    }
+  }
+
+  return UINT64_MAX;
+}
+
+uint64_t SimulatedChannel::getLineTime()
+{
+  return lineTime;
+}
+
+/**
+  * @brief  Take the faults that have arrived by now.
+  * @param  now:  The current time in nanoseconds.
+  * @param  time: The arrival time of the earliest fault taken.
+  * @return Whether any fault was taken.
+  */
+bool SimulatedChannel::takeFault(uint64_t now, uint64_t *time)
+{
+  if((faultTimes.empty() == true) || (faultTimes.front() > now))
+  {
+    return false;
+  }
+
+  *time = faultTimes.front();
+
+  while((faultTimes.empty() != true) && (faultTimes.front() <= now))
+  {
+    faultTimes.pop_front();
+  }
+
+  return true;
+}
+
+const SimulatedStats &SimulatedChannel::getStats()
+{
+  return stats;
+}
+
+bool SimulatedChannel::chance(double rate)
+{
+  return (rate > 0) && (std::uniform_real_distribution<double>(0.0, 1.0)(random) < rate);
+}
+
+void SimulatedChannel::deliver(uint64_t arrival, uint8_t value)
+{
+  Byte byte = {arrival, value};
+
+  queue.push_back(byte);
+
+  stats.bytesDelivered++;
+}
+
+SimulatedLink::SimulatedLink() :
+  time(0)
+{
+}
+
+void SimulatedLink::setFaults(uint32_t side, const SimulatedFaults &faults)
+{
+  channels[side & 1].setFaults(faults);
+}
+
+/**
+  * @brief  Seed both directions.
+  * @note   The directions draw from separate generators so that the faults on one do not
+  *         shift when the traffic on the other changes.
+  * @param  seed: The seed.
+  */
+void SimulatedLink::setSeed(uint32_t seed)
+{
+  channels[0].setSeed(seed * 2 + 0);
+  channels[1].setSeed(seed * 2 + 1);
+}
+
+SimulatedChannel &SimulatedLink::getChannel(uint32_t side)
+{
+  return channels[side & 1];
+}
+
+uint64_t SimulatedLink::getTime()
+{
+  return time;
+}
+
+void SimulatedLink::setTime(uint64_t time)
+{
+  this->time = time;
+}
+
+SimulatedSession::SimulatedSession(SimulatedLink *link, uint32_t side) :
+  link(link),
+  side(side & 1),
+  finished(false),
+  status(StatusEstablish)
+{
+}
+
+bool SimulatedSession::isFinished()
+{
+  return finished;
+}
+
+Ymodem::Status SimulatedSession::getStatus()
+{
+  return status;
+}
+
+/**
+  * @brief  Forward the ymodem callback to the session and track its status.
+  * @note   A cancelled establish or transmit step ends the session with StatusError.
+  */
+Ymodem::Code SimulatedSession::callback(Status status, uint8_t *buff, uint32_t *len)
+{
+  Code code = sessionCallback(status, buff, len);
+
+  switch(status)
+  {
+    case StatusEstablish:
+    case StatusTransmit:
+    {
+      if(code == CodeCan)
+      {
+        SimulatedSession::status = StatusError;
+        finished                 = true;
+      }
+      else
+      {
+        SimulatedSession::status = status;
+      }
+
+      break;
+    }
+
+    case StatusResume:
+    {
+      break;
+    }
+
+    default:
+    {
+      SimulatedSession::status = status;
+      finished                 = true;
+    }
+  }
+
+  return code;
+}
+
+uint32_t SimulatedSession::read(uint8_t *buff, uint32_t len)
+{
+  return link->getChannel(side ^ 1).read(link->getTime(), buff, len);
+}
+
+uint32_t SimulatedSession::write(uint8_t *buff, uint32_t len)
+{
+  link->getChannel(side).write(link->getTime(), buff, len);
+
+  return len;
+}
+
+uint32_t SimulatedSession::tick()
+{
+  return (uint32_t)(link->getTime() / 1000000);
+}
+
+uint64_t SimulatedSession::microTick()
+{
+  return link->getTime() / 1000;
+}
@@ -0,0 +1,145 @@
+/**
+  ******************************************************************************
+  * @file    SimulatedLink.h
+  * @author  SerialPortYmodem contributors
+  * @version v1.0
+  * @date    16-October-2026
+  * @brief   Header file for SimulatedLink.cpp module.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>Copyright &copy; 2026 SerialPortYmodem contributors</center></h2>
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#ifndef SIMULATEDLINK_H
+#define SIMULATEDLINK_H
+
+#include "Ymodem.h"
+#include <deque>
+#include <random>
+
+/*
+ * A serial line simulated in virtual time, in nanoseconds. Each direction paces bytes to the line rate
+ * of an 8N1 UART, delays them by a fixed latency and injects faults drawn from its own
+ * seeded generator, so a run with the same settings and seed is reproducible.
+ */
+struct SimulatedFaults
+{
+  double   bitErrorRate;    /* Probability of each bit being flipped. */
+  double   dropRate;        /* Probability of each byte being lost. */
+  double   duplicateRate;   /* Probability of each byte being delivered twice. */
+  double   burstRate;       /* Probability of a noise burst starting at each byte. */
+  uint32_t burstLength;     /* Bytes replaced with noise by a burst. */
+  uint32_t latency;         /* One-way latency in microseconds. */
+  uint32_t baudrate;        /* Line rate, 10 bits per byte. */
+};
+
+struct SimulatedStats
+{
+  uint64_t bytesWritten;
+  uint64_t bytesDelivered;
+  uint64_t bitsFlipped;
+  uint64_t bytesDropped;
+  uint64_t bytesDuplicated;
+  uint64_t bursts;
+};
+
+class SimulatedChannel
+{
+public:
+  SimulatedChannel();
+
+  void setFaults(const SimulatedFaults &faults);
+  void setSeed(uint32_t seed);
+
+  void write(uint64_t now, const uint8_t *buff, uint32_t len);
+  uint32_t read(uint64_t now, uint8_t *buff, uint32_t len);
+
+  uint32_t available(uint64_t now);
+  uint32_t backlog(uint64_t now);
+  uint64_t getNextArrival(uint64_t now);
+  uint64_t getLineTime();
+
+  bool takeFault(uint64_t now, uint64_t *time);
+
+  const SimulatedStats &getStats();
+
+private:
+  struct Byte
+  {
+    uint64_t arrival;
+    uint8_t  value;
+  };
+
+  bool chance(double rate);
+  void deliver(uint64_t arrival, uint8_t value);
+
+  SimulatedFaults      faults;
+  SimulatedStats       stats;
+  std::mt19937         random;
+  std::deque<Byte>     queue;
+  std::deque<uint64_t> faultTimes;
+  uint64_t             lineTime;
+  uint32_t             burstRemain;
+};
+
+class SimulatedLink
+{
+public:
+  SimulatedLink();
+
+  void setFaults(uint32_t side, const SimulatedFaults &faults);
+  void setSeed(uint32_t seed);
+
+  SimulatedChannel &getChannel(uint32_t side);
+
+  uint64_t getTime();
+  void setTime(uint64_t time);
+
+private:
+  SimulatedChannel channels[2];
+  uint64_t         time;
+};
+
+class SimulatedSession : public Ymodem
+{
+public:
+  SimulatedSession(SimulatedLink *link, uint32_t side);
+
+  bool isFinished();
+  Status getStatus();
+
+protected:
+  virtual Code sessionCallback(Status status, uint8_t *buff, uint32_t *len) = 0;
+
+private:
+  Code callback(Status status, uint8_t *buff, uint32_t *len);
+
+  uint32_t read(uint8_t *buff, uint32_t len);
+  uint32_t write(uint8_t *buff, uint32_t len);
+
+  uint32_t tick();
+  uint64_t microTick();
+
+  SimulatedLink *link;
+  uint32_t       side;
+  bool           finished;
+  Status         status;
+};
+
+#endif // SIMULATEDLINK_H
@@ -0,0 +1,188 @@
+/**
+  ******************************************************************************
+  * @file    ThroughputBenchmark.cpp
+  * @author  SerialPortYmodem contributors
+  * @version v1.0
+  * @date    16-October-2026
+  * @brief   Throughput benchmark over a pty loopback.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>Copyright &copy; 2026 SerialPortYmodem contributors</center></h2>
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#include "ThroughputBenchmark.h"
+#include "PtyLoopback.h"
+#include "MemorySession.h"
+#include <chrono>
+#include <vector>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/* Runs whose payload alone would take longer than this on a paced line are skipped. */
+#define THROUGHPUT_LINE_TIME_MAX  (120)
+
+static std::vector<uint64_t> parseList(const char *list)
+{
+  std::vector<uint64_t> values;
+
+  while(*list != '\0')
+  {
+    char     *end   = NULL;
+    uint64_t  value = strtoull(list, &end, 0);
+
+    switch(*end)
+    {
+      case 'K': case 'k': value <<= 10; end++; break;
+      case 'M': case 'm': value <<= 20; end++; break;
+      case 'G': case 'g': value <<= 30; end++; break;
+      default:                                 break;
+    }
+
+    if(end == list)
+    {
+      break;
+    }
+
+    values.push_back(value);
+
+    list = (*end == ',') ? end + 1 : end;
+  }
+
+  return values;
+}
+
+static const char *statusName(Ymodem::Status status)
+{
+  switch(status)
+  {
+    case Ymodem::StatusFinish:  return "finish";
+    case Ymodem::StatusAbort:   return "abort";
+    case Ymodem::StatusTimeout: return "timeout";
+    default:                    return "error";
+  }
+}
+
+/**
+  * @brief  Transfer one payload over a fresh pty link and print a CSV row.
+  * @param  size: The payload size in bytes.
+  * @param  baudrate: The line rate the link is paced to, 0 for an unpaced link.
+  * @param  options: The protocol options requested by the receiver.
+  * @return 0 on a verified transfer, 1 otherwise.
+  */
+static int throughputRun(uint32_t size, uint32_t baudrate, uint32_t options)
+{
+  PtyLoopback   loopback;
+  YmodemReactor reactor;
+
+  if(loopback.open(1, baudrate) != true)
+  {
+    printf("# failed to create a pty link\n");
+
+    return 1;
+  }
+
+  int transmit = YmodemReactorSession::openPort(loopback.getPortName(0, 0).c_str(), (baudrate != 0) ? baudrate : 115200);
+  int receive  = YmodemReactorSession::openPort(loopback.getPortName(0, 1).c_str(), (baudrate != 0) ? baudrate : 115200);
+
+  if((transmit < 0) || (receive < 0))
+  {
+    printf("# failed to open the pty link\n");
+
+    return 1;
+  }
+
+  MemoryTransmitSession transmitter(transmit, 0, size);
+  MemoryReceiveSession  receiver(receive, options);
+
+  reactor.add(&transmitter);
+  reactor.add(&receiver);
+
+  uint64_t start = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch()).count();
+
+  reactor.run();
+
+  uint64_t stop = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                  std::chrono::steady_clock::now().time_since_epoch()).count();
+
+  close(transmit);
+  close(receive);
+
+  bool match  = (receiver.getCount() == size) && (receiver.getCrc() == transmitter.getCrc());
+  bool finish = (transmitter.getStatus() == Ymodem::StatusFinish) && (receiver.getStatus() == Ymodem::StatusFinish);
+
+  const char *status = (match == true) ? "finish" : "mismatch";
+
+  if(transmitter.getStatus() != Ymodem::StatusFinish)
+  {
+    status = statusName(transmitter.getStatus());
+  }
+  else if(receiver.getStatus() != Ymodem::StatusFinish)
+  {
+    status = statusName(receiver.getStatus());
+  }
+
+  double seconds    = (stop - start) / 1000000000.0;
+  double rate       = (seconds > 0) ? (size / seconds) : 0.0;
+  double efficiency = (baudrate != 0) ? (rate / (baudrate / 10.0)) : 0.0;
+  double cpu        = reactor.getStats().cpuTime / 1000000.0;
+
+  printf("%u,%u,%u,%s,%.6f,%.0f,%.4f,%.3f,%.3f,%u,%u,%llu,%llu\n", size, baudrate, options, status, seconds,
+         rate, efficiency, cpu, (size != 0) ? (cpu * 1048576.0 / size) : 0.0, transmitter.getRetryCount(),
+         receiver.getRetryCount(), (unsigned long long)(transmitter.getStats().bytesWritten),
+         (unsigned long long)(receiver.getStats().bytesWritten));
+
+  return ((finish == true) && (match == true)) ? 0 : 1;
+}
+
+int throughputBenchmark(const char *sizes, const char *baudrates, const char *modes)
+{
+  std::vector<uint64_t> sizeList     = parseList(sizes);
+  std::vector<uint64_t> baudrateList = parseList(baudrates);
+  std::vector<uint64_t> modeList     = parseList(modes);
+
+  int result = 0;
+
+  printf("size,baudrate,options,status,seconds,bytes_per_second,efficiency,cpu_ms,cpu_ms_per_mb,"
+         "tx_retries,rx_retries,tx_bytes,rx_bytes\n");
+  fflush(stdout);
+
+  for(uint32_t i = 0; i < baudrateList.size(); i++)
+  {
+    for(uint32_t j = 0; j < modeList.size(); j++)
+    {
+      for(uint32_t k = 0; k < sizeList.size(); k++)
+      {
+        if((sizeList[k] > 0xFFFFFFFFULL) ||
+           ((baudrateList[i] != 0) && (sizeList[k] * 10 > baudrateList[i] * THROUGHPUT_LINE_TIME_MAX)))
+        {
+          continue;
+        }
+
+        result |= throughputRun((uint32_t)(sizeList[k]), (uint32_t)(baudrateList[i]), (uint32_t)(modeList[j]));
+
+        /* Rows are read live when the output is piped into another tool. */
+        fflush(stdout);
+      }
+    }
+  }
+
+  return result;
+}
@@ -0,0 +1,146 @@
+/**
+  ******************************************************************************
+  * @file    TransferManagerBenchmark.cpp
+  * @author  SerialPortYmodem contributors
+  * @version v1.0
+  * @date    16-October-2026
+  * @brief   Transfer manager benchmark over pty loopbacks.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>Copyright &copy; 2026 SerialPortYmodem contributors</center></h2>
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#include "TransferManagerBenchmark.h"
+#include "PtyLoopback.h"
+#include "YmodemTransferManager.h"
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QCoreApplication>
+#include <stdio.h>
+#include <stdlib.h>
+
+static const char *statusName(Ymodem::Status status)
+{
+  switch(status)
+  {
+    case Ymodem::StatusEstablish: return "establish";
+    case Ymodem::StatusTransmit:  return "transmit";
+    case Ymodem::StatusFinish:    return "finish";
+    case Ymodem::StatusAbort:     return "abort";
+    case Ymodem::StatusTimeout:   return "timeout";
+    default:                      return "error";
+  }
+}
+
+int transferManagerBenchmark(int argc, char *argv[], uint32_t links, uint32_t size, uint32_t threads)
+{
+  QCoreApplication      app(argc, argv);
+  QTemporaryDir         dir;
+  PtyLoopback           loopback;
+  YmodemTransferManager manager;
+
+  if((dir.isValid() != true) || (loopback.open(links) != true))
+  {
+    printf("failed to create %u pty links\n", links);
+
+    return 1;
+  }
+
+  srand(0);
+
+  for(uint32_t i = 0; i < links; i++)
+  {
+    QString    name = QString("%1/tx%2.bin").arg(dir.path()).arg(i);
+    QString    path = QString("%1/rx%2").arg(dir.path()).arg(i);
+    QByteArray data(size, 0);
+    QFile      file(name);
+
+    for(uint32_t j = 0; j < size; j++)
+    {
+      data[j] = (char)(rand());
+    }
+
+    if((file.open(QFile::WriteOnly) != true) || (file.write(data) != data.size()) ||
+       (QDir().mkpath(path) != true))
+    {
+      printf("failed to create %s\n", name.toLocal8Bit().data());
+
+      return 1;
+    }
+
+    file.close();
+
+    manager.addJob(QString::fromStdString(loopback.getPortName(i, 0)), 115200, name,
+                   YmodemTransferManager::DirectionTransmit);
+    manager.addJob(QString::fromStdString(loopback.getPortName(i, 1)), 115200, path,
+                   YmodemTransferManager::DirectionReceive, Ymodem::OptionExtended | Ymodem::OptionStreaming);
+  }
+
+  if(threads == 0)
+  {
+    threads = qMax(QThread::idealThreadCount(), 1);
+  }
+
+  /* Both ends of every link have to run at once. */
+  manager.setThreadCount(threads);
+  manager.setSessionCount((links * 2 + threads - 1) / threads);
+
+  QObject::connect(&manager, SIGNAL(finished()), &app, SLOT(quit()), Qt::QueuedConnection);
+
+  manager.start();
+  app.exec();
+
+  int result = 0;
+
+  printf("%-6s %-12s %-10s %-10s %12s %10s %12s\n", "job", "port", "direction", "status", "bytes", "ms", "bytes/s");
+
+  for(int i = 0; i < manager.getJobCount(); i++)
+  {
+    YmodemTransferManager::Job job = manager.getJob(i);
+
+    printf("%-6d %-12s %-10s %-10s %12llu %10lld %12.0f\n", i, job.portName.toLocal8Bit().data(),
+           (job.direction == YmodemTransferManager::DirectionTransmit) ? "transmit" : "receive",
+           statusName(job.status), (unsigned long long)(job.bytes), (long long)(job.elapsed),
+           (job.elapsed > 0) ? (job.bytes * 1000.0 / job.elapsed) : 0.0);
+
+    if(job.status != Ymodem::StatusFinish)
+    {
+      result = 1;
+    }
+  }
+
+  for(uint32_t i = 0; i < links; i++)
+  {
+    QFile source(QString("%1/tx%2.bin").arg(dir.path()).arg(i));
+    QFile target(QString("%1/rx%2/tx%2.bin").arg(dir.path()).arg(i));
+
+    if((source.open(QFile::ReadOnly) != true) || (target.open(QFile::ReadOnly) != true) ||
+       (source.readAll() != target.readAll()))
+    {
+      printf("link %u: received file does not match\n", i);
+
+      result = 1;
+    }
+  }
+
+  printf("total %llu bytes, %.0f bytes/s\n", (unsigned long long)(manager.getTotalBytes()), manager.getThroughput());
+
+  return result;
+}
@@ -0,0 +1,36 @@
+/**
+  ******************************************************************************
+  * @file    TransferManagerBenchmark.h
+  * @author  SerialPortYmodem contributors
+  * @version v1.0
+  * @date    16-October-2026
+  * @brief   Header file for TransferManagerBenchmark.cpp module.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>Copyright &copy; 2026 SerialPortYmodem contributors</center></h2>
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#ifndef TRANSFERMANAGERBENCHMARK_H
+#define TRANSFERMANAGERBENCHMARK_H
+
+#include <stdint.h>
+
+int transferManagerBenchmark(int argc, char *argv[], uint32_t links, uint32_t size, uint32_t threads);
+
+#endif // TRANSFERMANAGERBENCHMARK_H
@@ -0,0 +1,214 @@
+/**
+  ******************************************************************************
+  * @file    VariantBenchmark.cpp
+  * @author  SerialPortYmodem contributors
+  * @version v1.0
+  * @date    17-October-2026
+  * @brief   End-to-end benchmark of every core variant over a loopback.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>Copyright &copy; 2026 SerialPortYmodem contributors</center></h2>
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#include "VariantBenchmark.h"
+#include "MemoryTransfer.h"
+#include "YmodemCore.h"
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <stdio.h>
+
+#define VARIANT_TIME_LIMIT  (60)
+
+template<class Transport> using YmodemExtCore = YmodemCore<YMODEM_PACKET_EXT_SIZE, YmodemCrc16, true, Transport>;
+
+/*
+ * Transport of a loopback session: what one side writes is queued in memory for the other
+ * to read, so every core variant runs end-to-end without a port.
+ */
+template<class Transfer>
+class LoopbackTransport
+{
+public:
+  LoopbackTransport() : transfer(NULL), input(NULL), output(NULL), finished(false), status(YmodemBase::StatusEstablish)
+  {
+  }
+
+  void setTransfer(Transfer *transfer)
+  {
+    this->transfer = transfer;
+  }
+
+  void setLink(std::deque<uint8_t> *input, std::deque<uint8_t> *output)
+  {
+    this->input  = input;
+    this->output = output;
+  }
+
+  bool isFinished()
+  {
+    return finished;
+  }
+
+  YmodemBase::Status getStatus()
+  {
+    return status;
+  }
+
+protected:
+  YmodemBase::Code callback(YmodemBase::Status status, uint8_t *buff, uint32_t *len)
+  {
+    YmodemBase::Code code = transfer->transfer(status, buff, len);
+
+    if((status == YmodemBase::StatusEstablish) || (status == YmodemBase::StatusTransmit))
+    {
+      finished     = code == YmodemBase::CodeCan;
+      this->status = (finished == true) ? YmodemBase::StatusError : status;
+    }
+    else if(status != YmodemBase::StatusResume)
+    {
+      finished     = true;
+      this->status = status;
+    }
+
+    return code;
+  }
+
+  uint32_t read(uint8_t *buff, uint32_t len)
+  {
+    uint32_t length = (input->size() < len) ? (uint32_t)(input->size()) : len;
+
+    std::copy(input->begin(), input->begin() + length, buff);
+
+    input->erase(input->begin(), input->begin() + length);
+
+    return length;
+  }
+
+  uint32_t write(uint8_t *buff, uint32_t len)
+  {
+    output->insert(output->end(), buff, buff + len);
+
+    return len;
+  }
+
+  uint32_t tick()
+  {
+    return YmodemClock::tick();
+  }
+
+  uint64_t microTick()
+  {
+    return YmodemClock::microTick();
+  }
+
+private:
+  Transfer            *transfer;
+  std::deque<uint8_t> *input;
+  std::deque<uint8_t> *output;
+  bool                 finished;
+  YmodemBase::Status   status;
+};
+
+static const char *statusName(Ymodem::Status status)
+{
+  switch(status)
+  {
+    case Ymodem::StatusEstablish: return "establish";
+    case Ymodem::StatusTransmit:  return "transmit";
+    case Ymodem::StatusFinish:    return "finish";
+    case Ymodem::StatusAbort:     return "abort";
+    case Ymodem::StatusTimeout:   return "timeout";
+    default:                      return "error";
+  }
+}
+
+/**
+  * @brief  Transfer a payload between two sessions of one core variant.
+  * @note   Both sessions are stepped in turn until they finish or the time limit passes.
+  *         XMODEM pads the last packet, the receiver is told the size to drop the padding.
+  * @param  name: The name of the variant.
+  * @param  size: The payload size in bytes.
+  * @param  options: The protocol options requested by the receiver.
+  * @return 0 on a verified transfer, 1 otherwise.
+  */
+template<template<class> class Core>
+static int variantRun(const char *name, uint32_t size, uint32_t options)
+{
+  std::deque<uint8_t> forward;
+  std::deque<uint8_t> reverse;
+
+  MemoryTransmitter                          transmitter(0, size);
+  MemoryReceiver                             receiver(size);
+  Core<LoopbackTransport<MemoryTransmitter> > transmitSession;
+  Core<LoopbackTransport<MemoryReceiver> >    receiveSession;
+
+  transmitSession.setTransfer(&transmitter);
+  transmitSession.setLink(&reverse, &forward);
+  receiveSession.setTransfer(&receiver);
+  receiveSession.setLink(&forward, &reverse);
+  receiveSession.setOptions(options);
+
+  auto start    = std::chrono::steady_clock::now();
+  auto deadline = start + std::chrono::seconds(VARIANT_TIME_LIMIT);
+
+  while(((transmitSession.isFinished() != true) || (receiveSession.isFinished() != true)) &&
+        (std::chrono::steady_clock::now() < deadline))
+  {
+    if(transmitSession.isFinished() != true)
+    {
+      transmitSession.transmit();
+    }
+
+    if(receiveSession.isFinished() != true)
+    {
+      receiveSession.receive();
+    }
+  }
+
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  bool match  = (receiver.getCount() == size) && (receiver.getCrc() == transmitter.getCrc());
+  bool finish = (transmitSession.getStatus() == Ymodem::StatusFinish) && (receiveSession.getStatus() == Ymodem::StatusFinish);
+
+  Ymodem::Stats stats = transmitSession.getTransferStats();
+
+  printf("%-12s %10u %7u %-10s %10.3f %10.2f %8u %8u %8u %10s\n", name, size, options,
+         statusName((transmitSession.getStatus() != Ymodem::StatusFinish) ? transmitSession.getStatus() : receiveSession.getStatus()),
+         seconds, size / seconds / 1000000.0, stats.packets128, stats.packets1K, stats.packetsExtended,
+         (match == true) ? "ok" : "MISMATCH");
+
+  return ((finish == true) && (match == true)) ? 0 : 1;
+}
+
+int variantBenchmark(uint32_t size)
+{
+  int result = 0;
+
+  printf("%-12s %10s %7s %-10s %10s %10s %8s %8s %8s %10s\n", "variant", "size", "options", "status",
+         "seconds", "MB/s", "pkt_128", "pkt_1k", "pkt_ext", "data");
+
+  result |= variantRun<XmodemCore>("xmodem", size, 0);
+  result |= variantRun<XmodemCrcCore>("xmodem-crc", size, 0);
+  result |= variantRun<Xmodem1kCore>("xmodem-1k", size, 0);
+  result |= variantRun<Ymodem1kCore>("ymodem-1k", size, 0);
+  result |= variantRun<YmodemExtCore>("ymodem", size, Ymodem::OptionExtended);
+
+  return result;
+}
@@ -0,0 +1,140 @@
+/**
+  ******************************************************************************
+  * @file    main.cpp
+  * @author  SerialPortYmodem contributors
+  * @version v1.0
+  * @date    16-October-2026
+  * @brief   Benchmark entry point, runs the benchmark named by the first argument.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>Copyright &copy; 2026 SerialPortYmodem contributors</center></h2>
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#include "Crc16Benchmark.h"
+#include "FaultBenchmark.h"
+#include "ProtocolBenchmark.h"
+#include "VariantBenchmark.h"
+#ifdef YMODEM_BENCHMARK_PTY
+#include "TransferManagerBenchmark.h"
+#endif
+#ifdef YMODEM_BENCHMARK_REACTOR
+#include "ReactorBenchmark.h"
+#include "RingBenchmark.h"
+#include "ThroughputBenchmark.h"
+#endif
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static void usage(const char *name)
+{
+    printf("Usage: %s crc [size] [milliseconds]\n", name);
+    printf("       %s faults [key=value...]\n", name);
+    printf("       %s protocol\n", name);
+    printf("       %s variants [size]\n", name);
+#ifdef YMODEM_BENCHMARK_PTY
+    printf("       %s manager [links] [size] [threads]\n", name);
+#endif
+#ifdef YMODEM_BENCHMARK_REACTOR
+    printf("       %s reactor [links] [size] [options]\n", name);
+    printf("       %s ring [size] [tick] [options] [baudrate]\n", name);
+    printf("       %s throughput [sizes] [baudrates] [options]\n", name);
+#endif
+}
+
+int main(int argc, char *argv[])
+{
+    if((argc >= 2) && (strcmp(argv[1], "crc") == 0))
+    {
+        uint32_t milliseconds = (argc >= 4) ? (uint32_t)(strtoul(argv[3], NULL, 0)) : 1000;
+
+        if(argc >= 3)
+        {
+            return crc16Benchmark((uint32_t)(strtoul(argv[2], NULL, 0)), milliseconds);
+        }
+
+        int result = 0;
+
+        result |= crc16Benchmark(128, milliseconds);
+        result |= crc16Benchmark(1024, milliseconds);
+        result |= crc16Benchmark(65536, milliseconds);
+
+        return result;
+    }
+
+    if((argc >= 2) && (strcmp(argv[1], "faults") == 0))
+    {
+        return faultBenchmark(argc - 2, argv + 2);
+    }
+
+    if((argc >= 2) && (strcmp(argv[1], "protocol") == 0))
+    {
+        return protocolBenchmark();
+    }
+
+    if((argc >= 2) && (strcmp(argv[1], "variants") == 0))
+    {
+        return variantBenchmark((argc >= 3) ? (uint32_t)(strtoul(argv[2], NULL, 0)) : 1024 * 1024);
+    }
+
+#ifdef YMODEM_BENCHMARK_PTY
+    if((argc >= 2) && (strcmp(argv[1], "manager") == 0))
+    {
+        uint32_t links   = (argc >= 3) ? (uint32_t)(strtoul(argv[2], NULL, 0)) : 16;
+        uint32_t size    = (argc >= 4) ? (uint32_t)(strtoul(argv[3], NULL, 0)) : 1024 * 1024;
+        uint32_t threads = (argc >= 5) ? (uint32_t)(strtoul(argv[4], NULL, 0)) : 0;
+
+        return transferManagerBenchmark(argc, argv, links, size, threads);
+    }
+#endif
+
+#ifdef YMODEM_BENCHMARK_REACTOR
+    if((argc >= 2) && (strcmp(argv[1], "reactor") == 0))
+    {
+        uint32_t links   = (argc >= 3) ? (uint32_t)(strtoul(argv[2], NULL, 0)) : 256;
+        uint32_t size    = (argc >= 4) ? (uint32_t)(strtoul(argv[3], NULL, 0)) : 64 * 1024;
+        uint32_t options = (argc >= 5) ? (uint32_t)(strtoul(argv[4], NULL, 0)) : 0;
+
+        return reactorBenchmark(links, size, options);
+    }
+
+    if((argc >= 2) && (strcmp(argv[1], "ring") == 0))
+    {
+        uint32_t size     = (argc >= 3) ? (uint32_t)(strtoul(argv[2], NULL, 0)) : 16 * 1024 * 1024;
+        uint32_t tickTime = (argc >= 4) ? (uint32_t)(strtoul(argv[3], NULL, 0)) : 0;
+        uint32_t options  = (argc >= 5) ? (uint32_t)(strtoul(argv[4], NULL, 0)) : 0;
+        uint32_t baudrate = (argc >= 6) ? (uint32_t)(strtoul(argv[5], NULL, 0)) : 0;
+
+        return ringBenchmark(size, tickTime, options, baudrate);
+    }
+
+    if((argc >= 2) && (strcmp(argv[1], "throughput") == 0))
+    {
+        const char *sizes     = (argc >= 3) ? argv[2] : "1K,64K,1M,16M";
+        const char *baudrates = (argc >= 4) ? argv[3] : "0,115200,921600";
+        const char *options   = (argc >= 5) ? argv[4] : "0,1,2,4,5";
+
+        return throughputBenchmark(sizes, baudrates, options);
+    }
+#endif
+
+    usage(argv[0]);
+
+    return 2;
+}
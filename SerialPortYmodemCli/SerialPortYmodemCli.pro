@@ -0,0 +1,42 @@
+#-------------------------------------------------
+#
+# SerialPortYmodem command line tool.
+#
+#-------------------------------------------------
+
+QT       -= gui
+QT       += serialport
+
+CONFIG   += console c++11
+CONFIG   -= app_bundle
+
+TARGET = SerialPortYmodemCli
+TEMPLATE = app
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+INCLUDEPATH += ../SerialPortYmodem
+
+SOURCES += main.cpp \
+    YmodemCli.cpp \
+    ../SerialPortYmodem/Ymodem.cpp \
+    ../SerialPortYmodem/Crc16.cpp \
+    ../SerialPortYmodem/Crc32.cpp \
+    ../SerialPortYmodem/YmodemFileSource.cpp \
+    ../SerialPortYmodem/YmodemFileSink.cpp \
+    ../SerialPortYmodem/YmodemCompress.cpp \
+    ../SerialPortYmodem/YmodemDelta.cpp \
+    ../SerialPortYmodem/YmodemFileTransmit.cpp \
+    ../SerialPortYmodem/YmodemFileReceive.cpp
+
+HEADERS  += YmodemCli.h \
+    ../SerialPortYmodem/Ymodem.h \
+    ../SerialPortYmodem/YmodemCore.h \
+    ../SerialPortYmodem/Crc16.h \
+    ../SerialPortYmodem/Crc32.h \
+    ../SerialPortYmodem/YmodemFileSource.h \
+    ../SerialPortYmodem/YmodemFileSink.h \
+    ../SerialPortYmodem/YmodemCompress.h \
+    ../SerialPortYmodem/YmodemDelta.h \
+    ../SerialPortYmodem/YmodemFileTransmit.h \
+    ../SerialPortYmodem/YmodemFileReceive.h
@@ -0,0 +1,305 @@
+/**
+  ******************************************************************************
+  * @file    YmodemCli.cpp
+  * @author  SerialPortYmodem contributors
+  * @version v1.0
+  * @date    16-October-2026
+  * @brief   Headless command-line transfer tool.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>Copyright &copy; 2026 SerialPortYmodem contributors</center></h2>
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#include "YmodemCli.h"
+#include <QFileInfo>
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <signal.h>
+#include <stdio.h>
+
+#define POLL_TIME_OUT   (100)
+
+static volatile sig_atomic_t interrupted = 0;
+
+static void interrupt(int signal)
+{
+    Q_UNUSED(signal);
+
+    interrupted = 1;
+}
+
+static const char *statusName(Ymodem::Status status)
+{
+    switch(status)
+    {
+        case Ymodem::StatusFinish:  return "finish";
+        case Ymodem::StatusAbort:   return "abort";
+        case Ymodem::StatusTimeout: return "timeout";
+        default:                    return "error";
+    }
+}
+
+YmodemCli::YmodemCli(QObject *parent) :
+    QObject(parent),
+    ymodemFileTransmit(new YmodemFileTransmit(this)),
+    ymodemFileReceive(new YmodemFileReceive(this)),
+    pollTimer(new QTimer(this)),
+    transmit(true),
+    quiet(false),
+    progress(-1),
+    establishTime(-1)
+{
+    connect(ymodemFileTransmit, SIGNAL(transmitStatus(YmodemFileTransmit::Status)), this, SLOT(transmitStatus(YmodemFileTransmit::Status)));
+    connect(ymodemFileReceive, SIGNAL(receiveStatus(YmodemFileReceive::Status)), this, SLOT(receiveStatus(YmodemFileReceive::Status)));
+    connect(pollTimer, SIGNAL(timeout()), this, SLOT(pollTimeOut()));
+}
+
+YmodemCli::~YmodemCli()
+{
+}
+
+int YmodemCli::start(const QStringList &arguments)
+{
+    QCommandLineParser parser;
+
+    QCommandLineOption portOption(QStringList() << "p" << "port", "Serial port name.", "port");
+    QCommandLineOption baudOption(QStringList() << "b" << "baud", "Baud rate, 115200 by default.", "baud", "115200");
+    QCommandLineOption modeOption(QStringList() << "m" << "mode", "Receive mode: plain, streaming, window or extended.", "mode", "plain");
+    QCommandLineOption noResumeOption("no-resume", "Do not resume interrupted transfers.");
+    QCommandLineOption compressOption("compress", "Ask the transmitter to compress the data.");
+    QCommandLineOption baseOption("base", "Directory of the base files to send or receive a delta against.", "directory");
+    QCommandLineOption quietOption(QStringList() << "q" << "quiet", "Do not print progress.");
+
+    parser.setApplicationDescription("Send or receive files over a serial port with the Ymodem protocol.");
+    parser.addHelpOption();
+    parser.addOption(portOption);
+    parser.addOption(baudOption);
+    parser.addOption(modeOption);
+    parser.addOption(noResumeOption);
+    parser.addOption(compressOption);
+    parser.addOption(baseOption);
+    parser.addOption(quietOption);
+    parser.addPositionalArgument("command", "send or receive.");
+    parser.addPositionalArgument("paths", "Files or directories to send, or the directory to receive into.", "paths...");
+
+    if(parser.parse(arguments) != true)
+    {
+        fprintf(stderr, "%s\n", qPrintable(parser.errorText()));
+
+        return ExitUsage;
+    }
+
+    if(parser.isSet("help") == true)
+    {
+        printf("%s", qPrintable(parser.helpText()));
+
+        return ExitSuccess;
+    }
+
+    QStringList positional = parser.positionalArguments();
+    QString     command    = positional.isEmpty() ? QString() : positional.takeFirst();
+    bool        result     = false;
+    qint32      baudrate   = parser.value(baudOption).toInt(&result);
+    uint32_t    options    = parser.isSet(noResumeOption) ? Ymodem::OptionNone : Ymodem::OptionResume;
+    QString     mode       = parser.value(modeOption);
+
+    if(((command != "send") && (command != "receive")) || (positional.isEmpty() == true) ||
+       (parser.isSet(portOption) != true) || (result != true) || (baudrate <= 0))
+    {
+        fprintf(stderr, "%s", qPrintable(parser.helpText()));
+
+        return ExitUsage;
+    }
+
+    if(mode == "streaming")
+    {
+        options |= Ymodem::OptionStreaming;
+    }
+    else if(mode == "window")
+    {
+        options |= Ymodem::OptionWindow;
+    }
+    else if(mode == "extended")
+    {
+        options |= Ymodem::OptionExtended;
+    }
+    else if(mode != "plain")
+    {
+        fprintf(stderr, "Unknown mode: %s\n", qPrintable(mode));
+
+        return ExitUsage;
+    }
+
+    if(parser.isSet(compressOption) == true)
+    {
+        options |= Ymodem::OptionCompress;
+    }
+
+    if(parser.isSet(baseOption) == true)
+    {
+        options |= Ymodem::OptionDelta;
+    }
+
+    transmit = (command == "send");
+    quiet    = parser.isSet(quietOption);
+
+    if(transmit == true)
+    {
+        ymodemFileTransmit->setFileNames(positional);
+        ymodemFileTransmit->setPortName(parser.value(portOption));
+        ymodemFileTransmit->setPortBaudRate(baudrate);
+        ymodemFileTransmit->setBaseFilePath(parser.value(baseOption));
+        ymodemFileTransmit->setOptions((options & Ymodem::OptionResume) | Ymodem::OptionCompress | Ymodem::OptionDelta);
+
+        result = ymodemFileTransmit->startTransmit();
+    }
+    else
+    {
+        if((positional.size() != 1) || (QFileInfo(positional.first()).isDir() != true))
+        {
+            fprintf(stderr, "Not a directory: %s\n", qPrintable(positional.join(" ")));
+
+            return ExitUsage;
+        }
+
+        ymodemFileReceive->setFilePath(positional.first());
+        ymodemFileReceive->setPortName(parser.value(portOption));
+        ymodemFileReceive->setPortBaudRate(baudrate);
+        ymodemFileReceive->setBaseFilePath(parser.value(baseOption));
+        ymodemFileReceive->setOptions(options);
+
+        result = ymodemFileReceive->startReceive();
+    }
+
+    if(result != true)
+    {
+        fprintf(stderr, "Cannot open serial port %s\n", qPrintable(parser.value(portOption)));
+
+        return ExitPort;
+    }
+
+    signal(SIGINT, interrupt);
+    signal(SIGTERM, interrupt);
+
+    elapsedTimer.start();
+    pollTimer->start(POLL_TIME_OUT);
+
+    return -1;
+}
+
+void YmodemCli::transmitStatus(YmodemFileTransmit::Status status)
+{
+    sessionStatus(status);
+}
+
+void YmodemCli::receiveStatus(YmodemFileReceive::Status status)
+{
+    sessionStatus(status);
+}
+
+void YmodemCli::pollTimeOut()
+{
+    if(interrupted == 1)
+    {
+        interrupted = 2;
+
+        if(transmit == true)
+        {
+            ymodemFileTransmit->stopTransmit();
+        }
+        else
+        {
+            ymodemFileReceive->stopReceive();
+        }
+    }
+
+    int value = (transmit == true) ? ymodemFileTransmit->getTransmitProgress() : ymodemFileReceive->getReceiveProgress();
+
+    if((quiet != true) && (value != progress))
+    {
+        progress = value;
+
+        fprintf(stderr, "\r%3d%%", progress);
+        fflush(stderr);
+    }
+}
+
+void YmodemCli::sessionStatus(Ymodem::Status status)
+{
+    switch(status)
+    {
+        case Ymodem::StatusEstablish:
+        {
+            break;
+        }
+
+        case Ymodem::StatusTransmit:
+        {
+            if(establishTime < 0)
+            {
+                establishTime = elapsedTimer.elapsed();
+            }
+
+            break;
+        }
+
+        default:
+        {
+            pollTimer->stop();
+
+            if((quiet != true) && (progress >= 0))
+            {
+                fprintf(stderr, "\n");
+            }
+
+            printSummary(status);
+
+            switch(status)
+            {
+                case Ymodem::StatusFinish:  QCoreApplication::exit(ExitSuccess); break;
+                case Ymodem::StatusAbort:   QCoreApplication::exit(ExitAbort);   break;
+                case Ymodem::StatusTimeout: QCoreApplication::exit(ExitTimeout); break;
+                default:                    QCoreApplication::exit(ExitError);
+            }
+        }
+    }
+}
+
+void YmodemCli::printSummary(Ymodem::Status status)
+{
+    qint64        elapsed   = elapsedTimer.elapsed();
+    qint64        establish = (establishTime >= 0) ? establishTime : elapsed;
+    qint64        transfer  = elapsed - establish;
+    quint64       bytes     = (transmit == true) ? ymodemFileTransmit->getTransmitBytes() : ymodemFileReceive->getReceiveBytes();
+    Ymodem::Stats stats     = (transmit == true) ? ymodemFileTransmit->getTransferStats() : ymodemFileReceive->getTransferStats();
+
+    printf("status:     %s\n", statusName(status));
+    printf("bytes:      %llu\n", (unsigned long long)(bytes));
+    printf("elapsed:    %.3f s\n", elapsed / 1000.0);
+    printf("establish:  %.3f s\n", establish / 1000.0);
+    printf("transfer:   %.3f s\n", transfer / 1000.0);
+    printf("throughput: %.0f bytes/s\n", (transfer > 0) ? (bytes * 1000.0 / transfer) : 0.0);
+    printf("retries:    %u\n", stats.retries);
+    printf("packets:    %u sent, %u received, %u duplicates\n", stats.packetsSent, stats.packetsReceived, stats.duplicates);
+    printf("errors:     %u naks, %u crc errors, %u timeouts\n", stats.naks, stats.crcErrors, stats.timeouts);
+    printf("ack rtt:    %.1f/%.1f/%.1f ms min/avg/p99 (%u)\n", stats.rttMin / 1000.0, stats.rttAverage / 1000.0,
+           stats.rttP99 / 1000.0, stats.rttCount);
+    printf("callback:   %.3f s in %u calls\n", stats.callbackTime / 1000000.0, stats.callbackCount);
+    fflush(stdout);
+}
@@ -0,0 +1,79 @@
+/**
+  ******************************************************************************
+  * @file    YmodemCli.h
+  * @author  SerialPortYmodem contributors
+  * @version v1.0
+  * @date    16-October-2026
+  * @brief   Header file for YmodemCli.cpp module.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>Copyright &copy; 2026 SerialPortYmodem contributors</center></h2>
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#ifndef YMODEMCLI_H
+#define YMODEMCLI_H
+
+#include <QTimer>
+#include <QObject>
+#include <QStringList>
+#include <QElapsedTimer>
+#include "YmodemFileTransmit.h"
+#include "YmodemFileReceive.h"
+
+class YmodemCli : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Exit
+    {
+        ExitSuccess = 0,
+        ExitUsage   = 1,
+        ExitPort    = 2,
+        ExitAbort   = 3,
+        ExitTimeout = 4,
+        ExitError   = 5
+    };
+
+    explicit YmodemCli(QObject *parent = 0);
+    ~YmodemCli();
+
+    int start(const QStringList &arguments);
+
+private slots:
+    void transmitStatus(YmodemFileTransmit::Status status);
+    void receiveStatus(YmodemFileReceive::Status status);
+    void pollTimeOut();
+
+private:
+    void sessionStatus(Ymodem::Status status);
+    void printSummary(Ymodem::Status status);
+
+    YmodemFileTransmit *ymodemFileTransmit;
+    YmodemFileReceive  *ymodemFileReceive;
+    QTimer             *pollTimer;
+    QElapsedTimer       elapsedTimer;
+
+    bool   transmit;
+    bool   quiet;
+    int    progress;
+    qint64 establishTime;
+};
+
+#endif // YMODEMCLI_H